@@ -0,0 +1,159 @@
+#ifndef HEADER_OLNY_INLINE
+#include "AsyncLog.hpp"
+#endif
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#ifndef HEADER_OLNY_INLINE
+#define HEADER_OLNY_INLINE
+#define HEADER_OLNY_STATIC
+#endif
+
+HEADER_OLNY_INLINE bool LogRing::push(const LogRecord &record)
+{
+	uint32_t h = head.load(std::memory_order_relaxed);
+	if (h - tail.load(std::memory_order_acquire) >= SIZE)
+	{
+		dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	records[h % SIZE] = record;
+	head.store(h + 1, std::memory_order_release);
+	return true;
+}
+
+HEADER_OLNY_INLINE bool LogRing::pop(LogRecord &record)
+{
+	uint32_t t = tail.load(std::memory_order_relaxed);
+	if (t == head.load(std::memory_order_acquire))
+		return false;
+
+	record = records[t % SIZE];
+	tail.store(t + 1, std::memory_order_release);
+	return true;
+}
+
+HEADER_OLNY_INLINE AsyncLogger &AsyncLogger::instance()
+{
+	static AsyncLogger logger;
+	return logger;
+}
+
+HEADER_OLNY_INLINE AsyncLogger::~AsyncLogger()
+{
+	stopped = true;
+	if (drainer.joinable())
+		drainer.join();
+	drain();
+
+	uint32_t dropped = droppedTotal;
+	for (const std::unique_ptr<LogRing> &ring : rings)
+		dropped += ring->dropped;
+	if (dropped)
+		std::cerr << "LOG dropped " << dropped << " records" << std::endl;
+}
+
+HEADER_OLNY_INLINE LogRing *AsyncLogger::registerThread()
+{
+	std::lock_guard<std::mutex> lock(ringsMutex);
+	rings.emplace_back(new LogRing());
+	if (!started.exchange(true))
+		drainer = std::thread(&AsyncLogger::run, this);
+	return rings.back().get();
+}
+
+HEADER_OLNY_INLINE void AsyncLogger::write(const LogRecord &record)
+{
+	// The ring outlives its thread until the drainer has printed it
+	struct Holder
+	{
+		LogRing *ring = nullptr;
+		~Holder() { if (ring) ring->released = true; }
+	};
+	static thread_local Holder holder;
+
+	if (!holder.ring)
+		holder.ring = registerThread();
+	holder.ring->push(record);
+}
+
+HEADER_OLNY_INLINE void AsyncLogger::flush()
+{
+	drain();
+}
+
+HEADER_OLNY_INLINE void AsyncLogger::setOutput(std::ostream *out)
+{
+	std::lock_guard<std::mutex> lock(drainMutex);
+	this->out = out;
+}
+
+HEADER_OLNY_INLINE bool AsyncLogger::drain()
+{
+	std::lock_guard<std::mutex> drainLock(drainMutex);
+
+	std::vector<LogRing*> current;
+	std::vector<bool> released;
+	{
+		std::lock_guard<std::mutex> lock(ringsMutex);
+		for (const std::unique_ptr<LogRing> &ring : rings)
+		{
+			// released is read before the records, so nothing is pushed after the last pop
+			released.push_back(ring->released);
+			current.push_back(ring.get());
+		}
+	}
+
+	std::string text;
+	LogRecord record;
+	for (LogRing *ring : current)
+	{
+		while (ring->pop(record))
+		{
+			if (record.tick != LOG_NO_TICK)
+			{
+				text += std::to_string(record.tick);
+				text += ' ';
+			}
+			text += record.text;
+			for (int i = 0; i < record.argsCount; ++i)
+			{
+				text += ' ';
+				text += std::to_string(record.args[i]);
+			}
+			text += '\n';
+		}
+	}
+
+	if (!text.empty())
+	{
+		std::ostream &str = out ? *out : std::cout;
+		str << text << std::flush;
+	}
+
+	{
+		// Rings are only appended, so current is a prefix of rings
+		std::lock_guard<std::mutex> lock(ringsMutex);
+		for (size_t i = current.size(); i-- > 0; )
+		{
+			if (released[i])
+			{
+				droppedTotal += rings[i]->dropped;
+				rings.erase(rings.begin() + i);
+			}
+		}
+	}
+
+	return !text.empty();
+}
+
+HEADER_OLNY_INLINE void AsyncLogger::run()
+{
+	while (!stopped)
+	{
+		if (!drain())
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
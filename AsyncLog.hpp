@@ -0,0 +1,141 @@
+#ifndef ASYNC_LOG_HPP
+#define ASYNC_LOG_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+#define LOG_LEVEL_NONE -1
+#define LOG_LEVEL_ERROR 0
+#define LOG_LEVEL_WARN 1
+#define LOG_LEVEL_INFO 2
+#define LOG_LEVEL_DEBUG 3
+
+// Records above LOG_LEVEL are compiled out together with their arguments
+#ifndef LOG_LEVEL
+#if ENABLE_LOGGING
+#define LOG_LEVEL LOG_LEVEL_DEBUG
+#else
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+#endif
+
+constexpr int LOG_NO_TICK = INT32_MIN;
+
+enum class LogLevel : uint8_t
+{
+	ERROR = LOG_LEVEL_ERROR,
+	WARN = LOG_LEVEL_WARN,
+	INFO = LOG_LEVEL_INFO,
+	DEBUG = LOG_LEVEL_DEBUG
+};
+
+// Unformatted record, printed by the drainer as "tick text arg0 arg1 ..."
+// (LOG_NO_TICK is omitted). text must be a string literal.
+struct LogRecord
+{
+	static constexpr int MAX_ARGS = 4;
+
+	const char *text;
+	int64_t args[MAX_ARGS];
+	int32_t tick;
+	uint8_t argsCount;
+	LogLevel level;
+};
+
+// Single producer single consumer ring, one per logging thread
+struct LogRing
+{
+	static constexpr uint32_t SIZE = 1024;
+
+	LogRecord records[SIZE];
+	std::atomic<uint32_t> head{0}; // written by the producer
+	std::atomic<uint32_t> tail{0}; // written by the consumer
+	std::atomic<uint32_t> dropped{0};
+	std::atomic<bool> released{false}; // producer thread has exited
+
+	bool push(const LogRecord &record);
+	bool pop(LogRecord &record);
+};
+
+// Owner of the rings and the background thread that formats them. Producers
+// never lock or flush: a full ring drops the record and counts it.
+class AsyncLogger
+{
+public:
+	~AsyncLogger();
+
+	void write(const LogRecord &record);
+	// Blocks until every record pushed before the call is printed
+	void flush();
+	void setOutput(std::ostream *out);
+
+	static AsyncLogger &instance();
+
+private:
+	LogRing *registerThread();
+	bool drain();
+	void run();
+
+	std::mutex ringsMutex;
+	std::vector<std::unique_ptr<LogRing>> rings;
+	uint32_t droppedTotal = 0;
+	std::mutex drainMutex;
+	std::ostream *out = nullptr;
+	std::thread drainer;
+	std::atomic<bool> started{false};
+	std::atomic<bool> stopped{false};
+};
+
+template<typename ...Args>
+inline void asyncLog(LogLevel level, int tick, const char *text, Args ...args)
+{
+	static_assert(sizeof...(Args) <= LogRecord::MAX_ARGS, "Too many log arguments");
+
+	LogRecord record;
+	record.text = text;
+	record.tick = tick;
+	record.level = level;
+	record.argsCount = sizeof...(Args);
+	int64_t values[] = {0, (int64_t) args...};
+	for (int i = 0; i < (int) sizeof...(Args); ++i)
+		record.args[i] = values[i + 1];
+
+	AsyncLogger::instance().write(record);
+}
+
+inline void flushLog()
+{
+	AsyncLogger::instance().flush();
+}
+
+// LOGE(tick, "text", args...), integer arguments only
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOGE(...) asyncLog(LogLevel::ERROR, __VA_ARGS__)
+#else
+#define LOGE(...) ((void) 0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOGW(...) asyncLog(LogLevel::WARN, __VA_ARGS__)
+#else
+#define LOGW(...) ((void) 0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOGI(...) asyncLog(LogLevel::INFO, __VA_ARGS__)
+#else
+#define LOGI(...) ((void) 0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOGD(...) asyncLog(LogLevel::DEBUG, __VA_ARGS__)
+#else
+#define LOGD(...) ((void) 0)
+#endif
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef HEADER_OLNY_INLINE
+#include "Divergence.hpp"
+#endif
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#ifndef HEADER_OLNY_INLINE
+#define HEADER_OLNY_INLINE
+#define HEADER_OLNY_STATIC
+#endif
+
+HEADER_OLNY_STATIC const char * DIVERGENCE_FIELD_NAMES[] = {
+	"pass.x",
+	"pass.y",
+	"pass.from",
+	"pass.dest",
+	"pass.tta",
+	"pass.elevator",
+	"pass.state",
+	"pass.mass",
+	"pass.missing",
+	"pass.reregistered",
+	"el.y",
+	"el.speed",
+	"el.next_floor",
+	"el.state",
+	"el.roster",
+	"enemy.el.y",
+	"enemy.el.speed",
+	"enemy.el.next_floor",
+	"enemy.el.state",
+	"enemy.el.roster"
+};
+HEADER_OLNY_INLINE const char * getDivergenceFieldName(DivergenceField field) {
+	return DIVERGENCE_FIELD_NAMES[(int) field];
+}
+
+HEADER_OLNY_INLINE void DivergenceTracker::beginTick(int tick)
+{
+	current.tick = tick;
+	current.fieldMask = 0;
+	current.count = 0;
+}
+
+HEADER_OLNY_INLINE void DivergenceTracker::record(DivergenceField field, double predicted, double observed)
+{
+	int f = (int) field;
+	double error = std::abs(observed - predicted);
+	int bucket = 0;
+	for (double bound = 0.001; bucket < ERROR_BUCKETS - 1 && error >= bound; bound *= 10.0)
+		++bucket;
+
+	FieldStats &stats = fields[f];
+	++stats.count;
+	++stats.errors[bucket];
+	if (error > stats.maxError)
+	{
+		stats.maxError = error;
+		stats.maxErrorTick = current.tick;
+	}
+
+	if (field == DivergenceField::PASS_STATE || field == DivergenceField::EL_STATE)
+	{
+		int p = (int) predicted, o = (int) observed;
+		if (p >= 0 && p < STATES_COUNT && o >= 0 && o < STATES_COUNT)
+			++stateTransitions[field == DivergenceField::EL_STATE][p][o];
+	}
+
+	if (isEnemyDivergenceField(field))
+		return;
+
+	if (!(current.fieldMask & (1u << f)) || error > current.maxError[f])
+		current.maxError[f] = (float) error;
+	current.fieldMask |= 1u << f;
+	++current.count;
+}
+
+HEADER_OLNY_INLINE void DivergenceTracker::endTick()
+{
+	++ticks;
+	if (!current.count)
+		return;
+
+	++divergentTicks;
+	if (ring.size() < RING_SIZE)
+		ring.push_back(current);
+	else
+		ring[ringPos] = current;
+	ringPos = (ringPos + 1) % RING_SIZE;
+}
+
+HEADER_OLNY_INLINE void DivergenceTracker::dump(std::ostream &out) const
+{
+	out << "DIVERGENCE ticks " << ticks << " divergent " << divergentTicks << " comparisons " << comparisons << "\n";
+	for (int f = 0; f < FIELDS_COUNT; ++f)
+	{
+		const FieldStats &stats = fields[f];
+		if (!stats.count)
+			continue;
+
+		out << "  " << getDivergenceFieldName((DivergenceField) f) << " " << stats.count
+			<< " max " << stats.maxError << " at " << stats.maxErrorTick << " err<1e-3.. ";
+		for (int b = 0; b < ERROR_BUCKETS; ++b)
+			out << (b ? "/" : "") << stats.errors[b];
+		out << "\n";
+	}
+
+	for (int e = 0; e < 2; ++e)
+	{
+		for (int p = 0; p < STATES_COUNT; ++p)
+		{
+			for (int o = 0; o < STATES_COUNT; ++o)
+			{
+				if (stateTransitions[e][p][o])
+					out << "  " << (e ? "el" : "pass") << " state " << p << " -> " << o << " " << stateTransitions[e][p][o] << "\n";
+			}
+		}
+	}
+
+	// oldest first
+	for (size_t i = 0; i < ring.size(); ++i)
+	{
+		const DivergentTick &t = ring[(ringPos + i) % ring.size()];
+		out << "  TICK " << t.tick << " " << t.count;
+		for (int f = 0; f < FIELDS_COUNT; ++f)
+		{
+			if (t.fieldMask & (1u << f))
+				out << " " << getDivergenceFieldName((DivergenceField) f) << " " << t.maxError[f];
+		}
+		out << "\n";
+	}
+	out << std::flush;
+}
@@ -0,0 +1,96 @@
+#ifndef DIVERGENCE_HPP
+#define DIVERGENCE_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// Values the strategy.h adapter gets from the server and the shadow
+// Simulator has predicted
+enum class DivergenceField
+{
+	PASS_X,
+	PASS_Y,
+	PASS_FROM,
+	PASS_DEST,
+	PASS_TTA,
+	PASS_ELEVATOR,
+	PASS_STATE,
+	PASS_MASS,
+	PASS_MISSING,       // predicted passenger the server doesn't have
+	PASS_REREGISTERED,  // known passenger disappeared from the simulator and came back
+	EL_Y,
+	EL_SPEED,
+	EL_NEXT_FLOOR,
+	EL_STATE,
+	EL_ROSTER,
+	// Enemy elevators follow commands we don't see, so their fields are kept
+	// apart and don't make a tick divergent
+	ENEMY_EL_Y,
+	ENEMY_EL_SPEED,
+	ENEMY_EL_NEXT_FLOOR,
+	ENEMY_EL_STATE,
+	ENEMY_EL_ROSTER,
+	COUNT
+};
+
+const char * getDivergenceFieldName(DivergenceField field);
+inline bool isEnemyDivergenceField(DivergenceField field) { return field >= DivergenceField::ENEMY_EL_Y; }
+
+// Predicted vs observed per field: counts, absolute error histogram by decades
+// and, for the state fields, predicted -> observed state counts. The last
+// RING_SIZE ticks with divergences are kept with their worst error per field.
+struct DivergenceTracker
+{
+	static constexpr int FIELDS_COUNT = (int) DivergenceField::COUNT;
+	static constexpr int ERROR_BUCKETS = 7; // < 0.001, < 0.01, ... < 100, >= 100
+	static constexpr int STATES_COUNT = 8;
+	static constexpr size_t RING_SIZE = 64;
+	static constexpr double EPSILON = 1e-9; // rounding of the api's 1-based floors, not a divergence
+
+	struct FieldStats
+	{
+		uint64_t count = 0;
+		uint32_t errors[ERROR_BUCKETS] = {};
+		double maxError = 0.0;
+		int maxErrorTick = -1;
+	};
+
+	struct DivergentTick
+	{
+		int tick;
+		uint32_t fieldMask;
+		uint32_t count;
+		float maxError[FIELDS_COUNT];
+	};
+
+	FieldStats fields[FIELDS_COUNT];
+	uint32_t stateTransitions[2][STATES_COUNT][STATES_COUNT] = {}; // [passenger/elevator][predicted][observed]
+	uint64_t comparisons = 0;
+	int ticks = 0;
+	int divergentTicks = 0;
+
+	void beginTick(int tick);
+	// true if the values differ, differences below EPSILON are not recorded
+	template <typename T>
+	bool compare(DivergenceField field, const T &predicted, const T &observed)
+	{
+		++comparisons;
+		if (predicted == observed)
+			return false;
+		if (std::abs((double) observed - (double) predicted) >= EPSILON)
+			record(field, (double) predicted, (double) observed);
+		return true;
+	}
+	void record(DivergenceField field, double predicted, double observed);
+	void endTick();
+	void dump(std::ostream &out) const;
+
+private:
+	std::vector<DivergentTick> ring;
+	size_t ringPos = 0;
+	DivergentTick current;
+};
+
+#endif
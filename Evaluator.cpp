@@ -0,0 +1,160 @@
+#ifndef HEADER_OLNY_INLINE
+#include "Evaluator.hpp"
+#endif
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#endif
+
+#ifndef HEADER_OLNY_INLINE
+#define HEADER_OLNY_INLINE
+#define HEADER_OLNY_STATIC
+#endif
+
+HEADER_OLNY_STATIC const char * EVALUATOR_FEATURE_NAMES[] = {
+	"bias",
+	"scoreLead",
+	"passengersLead",
+	"cargoPoints",
+	"enemyCargoPoints",
+	"cargoTicks",
+	"enemyCargoTicks",
+	"cargoAtTarget",
+	"enemyCargoAtTarget",
+	"cargoFloors",
+	"enemyCargoFloors",
+	"waitingAtTarget",
+	"waitingNear",
+	"waitingNearEnemy",
+	"",
+	""
+};
+
+HEADER_OLNY_INLINE float StateEvaluator::evaluate(Simulator &sim, Side side, float coef) const
+{
+	alignas(16) float features[FEATURES];
+	getFeatures(sim, side, coef, features);
+
+#if defined(__SSE__) || defined(_M_X64)
+	__m128 sum = _mm_setzero_ps();
+	for (int i = 0; i < FEATURES; i += 4)
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_load_ps(weights + i), _mm_load_ps(features + i)));
+	alignas(16) float parts[4];
+	_mm_store_ps(parts, sum);
+	return (parts[0] + parts[1]) + (parts[2] + parts[3]);
+#else
+	float sum = 0;
+	for (int i = 0; i < FEATURES; ++i)
+		sum += weights[i] * features[i];
+	return sum;
+#endif
+}
+
+// Within a few hundred ticks of a closing the candidates mostly differ in where
+// the elevators are and what they are about to deliver or take
+HEADER_OLNY_INLINE void StateEvaluator::getFeatures(Simulator &sim, Side side, float coef, float features[FEATURES])
+{
+	Side enemy = inverseSide(side);
+	int our = (int) side;
+	int their = (int) enemy;
+	Value cargo = sim.totalCargoValue2(side);
+	Value enemyCargo = sim.totalCargoValue2(enemy);
+
+	float cargoAtTarget[2] = {};
+	float cargoFloors[2] = {};   // floors left to ride, weighted by value
+	int targetFloors[2] = {};    // bit masks of the floors the elevators stop on next
+	int nearFloors[2] = {};      // within one floor of an elevator
+	for (MyElevator &elevator : sim.elevators)
+	{
+		int s = (int) elevator.side;
+		int target = elevator.state == EState::MOVING ? elevator.next_floor : elevator.getFloor();
+		targetFloors[s] |= 1 << target;
+		nearFloors[s] |= 7 << elevator.getFloor() >> 1;
+		for (int id : elevator.passengers)
+		{
+			MyPassenger &passenger = sim.passengers[id];
+			int value = passenger.getValue(elevator.side);
+			if (passenger.dest_floor == target)
+				cargoAtTarget[s] += value;
+			cargoFloors[s] += value * std::abs(passenger.dest_floor - elevator.y) * 0.1f;
+		}
+	}
+
+	float waitingAtTarget = 0;
+	float waitingNear[2] = {};
+	for (std::pair<const int, MyPassenger> &passengerEntry : sim.passengers)
+	{
+		MyPassenger &passenger = passengerEntry.second;
+		if (passenger.state != PState::WAITING_FOR_ELEVATOR && passenger.state != PState::RETURNING)
+			continue;
+
+		int value = passenger.getValue(side);
+		int bit = 1 << passenger.getFloor();
+		if (targetFloors[our] & bit)
+			waitingAtTarget += value;
+		for (int s = 0; s < 2; ++s)
+		{
+			if (nearFloors[s] & bit)
+				waitingNear[s] += value;
+		}
+	}
+
+	features[0] = 1.0f;
+	features[1] = sim.scores[our] - sim.scores[their];
+	features[2] = sim.passengersTotal[our] - sim.passengersTotal[their];
+	features[3] = coef * cargo.points;
+	features[4] = coef * enemyCargo.points;
+	features[5] = cargo.ticks * 0.01f;
+	features[6] = enemyCargo.ticks * 0.01f;
+	features[7] = cargoAtTarget[our];
+	features[8] = cargoAtTarget[their];
+	features[9] = cargoFloors[our];
+	features[10] = cargoFloors[their];
+	features[11] = waitingAtTarget;
+	features[12] = waitingNear[our];
+	features[13] = waitingNear[their];
+	for (int i = USED_FEATURES; i < FEATURES; ++i)
+		features[i] = 0.0f;
+}
+
+HEADER_OLNY_INLINE const char *StateEvaluator::getFeatureName(int feature)
+{
+	return EVALUATOR_FEATURE_NAMES[feature];
+}
+
+HEADER_OLNY_INLINE bool StateEvaluator::load(const std::string &path)
+{
+	std::ifstream in(path);
+	std::string key;
+	if (!(in >> key >> horizon) || key != "horizon" || horizon <= 0)
+		return false;
+
+	for (float &weight : weights)
+	{
+		if (!(in >> weight))
+			return false;
+	}
+	return true;
+}
+
+HEADER_OLNY_INLINE bool StateEvaluator::save(const std::string &path) const
+{
+	std::ofstream out(path);
+	out << toString();
+	return (bool) out;
+}
+
+HEADER_OLNY_INLINE std::string StateEvaluator::toString() const
+{
+	std::ostringstream out;
+	out << "horizon " << horizon << std::endl;
+	out.precision(9);
+	for (int i = 0; i < FEATURES; ++i)
+		out << (i ? " " : "") << weights[i];
+	out << std::endl;
+	return out.str();
+}
@@ -0,0 +1,36 @@
+#ifndef EVALUATOR_HPP
+#define EVALUATOR_HPP
+
+#ifndef HEADER_OLNY_INLINE
+#include "Strategy.hpp"
+#endif
+
+#include <string>
+
+// Linear model of the getRolloutValue a full-length rollout would end with,
+// from the state after a horizon-tick rollout. Trained by arena
+// --train-evaluator on the closing-time rollouts of self-play games. The
+// trained models lose to full rollouts (0.948 against MyStrategy at 300
+// ticks, 0.907 at 200), so none is built in: arena --evaluator file only.
+struct StateEvaluator
+{
+	static constexpr int FEATURES = 16; // padded to whole SIMD registers
+	static constexpr int USED_FEATURES = 14;
+	static constexpr int DEFAULT_HORIZON = 300;
+
+	int horizon = DEFAULT_HORIZON;
+	alignas(16) float weights[FEATURES] = {};
+
+	float evaluate(Simulator &sim, Side side, float coef) const;
+
+	// Our side against the enemy, coef - weight of the cargo as in getRolloutValue
+	static void getFeatures(Simulator &sim, Side side, float coef, float features[FEATURES]);
+	static const char *getFeatureName(int feature);
+
+	// "horizon h" line and the weights line
+	bool load(const std::string &path);
+	bool save(const std::string &path) const;
+	std::string toString() const;
+};
+
+#endif
@@ -0,0 +1,266 @@
+#include "EvaluatorTrainer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include "mystrategy.hpp"
+
+namespace {
+
+const int FEATURES = StateEvaluator::FEATURES;
+
+struct Sample
+{
+	float features[FEATURES];
+	float shortValue;   // getRolloutValue after horizon ticks
+	float target;       // getRolloutValue at the full length
+};
+
+// Candidate floors of one closing decision
+typedef std::vector<Sample> Decision;
+
+void addDecision(const MyStrategy &strategy, Simulator &world, const MyElevator &elevator, int horizon, std::vector<Decision> &decisions)
+{
+	MyStrategy snapshot = strategy;
+	snapshot.sim.synchronizeWith(world);
+	MyElevator &shadow = snapshot.sim.elevators[elevator.id];
+	ElevatorStrategyUpDown &elevatorStrategy = snapshot.getElevatorStrategy(shadow.ind);
+
+	Decision decision;
+	for (int floor = 0; floor < LEVELS_COUNT; ++floor)
+	{
+		if (floor == shadow.getFloor())
+			continue;
+
+		DestinationRollout rollout(snapshot);
+		elevatorStrategy.startRollout(rollout, snapshot.sim, shadow, floor, 0);
+		if (rollout.length <= horizon)
+			return;
+
+		Sample sample;
+		rollout.advance(horizon);
+		StateEvaluator::getFeatures(rollout.copy.sim, rollout.copy.side, rollout.coef, sample.features);
+		sample.shortValue = elevatorStrategy.getRolloutValue(rollout.copy, rollout.coef);
+		rollout.advance(rollout.length);
+		sample.target = elevatorStrategy.getRolloutValue(rollout.copy, rollout.coef);
+		decision.push_back(sample);
+	}
+	decisions.push_back(decision);
+}
+
+std::vector<Decision> collectDecisions(int game, int horizon)
+{
+	Simulator world;
+	world.random.m_w = 251000 + game*12345;
+	MyStrategy left(Side::LEFT);
+	MyStrategy right(Side::RIGHT);
+	left.sim.random.m_w = 30000 + game*89741;
+
+	std::vector<Decision> decisions;
+	for (int j = 0; j < 7200; ++j)
+	{
+		for (MyStrategy *strategy : {&left, &right})
+		{
+			for (MyElevator &elevator : world.elevators)
+			{
+				if (elevator.side == strategy->side && elevator.state == EState::CLOSING && elevator.closing_or_opening_ticks == 98)
+					addDecision(*strategy, world, elevator, horizon, decisions);
+			}
+		}
+
+		left.makeMove(world);
+		right.makeMove(world);
+		world.step();
+	}
+	return decisions;
+}
+
+// Solves a x = b in place, false if a is singular
+bool solve(std::vector<std::vector<double>> &a, std::vector<double> &b, std::vector<double> &x)
+{
+	int n = b.size();
+	for (int c = 0; c < n; ++c)
+	{
+		int pivot = c;
+		for (int r = c + 1; r < n; ++r)
+		{
+			if (std::abs(a[r][c]) > std::abs(a[pivot][c]))
+				pivot = r;
+		}
+		if (std::abs(a[pivot][c]) < 1e-12)
+			return false;
+		std::swap(a[c], a[pivot]);
+		std::swap(b[c], b[pivot]);
+
+		for (int r = c + 1; r < n; ++r)
+		{
+			double k = a[r][c] / a[c][c];
+			for (int i = c; i < n; ++i)
+				a[r][i] -= k * a[c][i];
+			b[r] -= k * b[c];
+		}
+	}
+
+	x.assign(n, 0.0);
+	for (int r = n - 1; r >= 0; --r)
+	{
+		double sum = b[r];
+		for (int i = r + 1; i < n; ++i)
+			sum -= a[r][i] * x[i];
+		x[r] = sum / a[r][r];
+	}
+	return true;
+}
+
+// Candidates are only compared within their decision, so the features and
+// the target are centered per decision before the ridge regression on the
+// standardized features. The bias stays 0.
+void center(const Decision &decision, std::vector<Sample> &out)
+{
+	Sample mean = {};
+	for (const Sample &sample : decision)
+	{
+		for (int i = 0; i < FEATURES; ++i)
+			mean.features[i] += sample.features[i] / decision.size();
+		mean.target += sample.target / decision.size();
+	}
+	for (Sample sample : decision)
+	{
+		for (int i = 0; i < FEATURES; ++i)
+			sample.features[i] -= mean.features[i];
+		sample.target -= mean.target;
+		out.push_back(sample);
+	}
+}
+
+bool fit(const std::vector<Decision> &decisions, double ridge, StateEvaluator &evaluator)
+{
+	const int n = StateEvaluator::USED_FEATURES;
+	std::vector<Sample> samples;
+	for (const Decision &decision : decisions)
+		center(decision, samples);
+	if (samples.empty())
+		return false;
+
+	std::vector<double> sd(n, 0.0);
+	for (const Sample &sample : samples)
+	{
+		for (int i = 0; i < n; ++i)
+			sd[i] += sample.features[i] * sample.features[i];
+	}
+	for (double &s : sd)
+		s = std::max(1e-6, std::sqrt(s / samples.size()));
+
+	std::vector<std::vector<double>> a(n, std::vector<double>(n, 0.0));
+	std::vector<double> b(n, 0.0);
+	double z[n];
+	for (const Sample &sample : samples)
+	{
+		for (int i = 0; i < n; ++i)
+			z[i] = sample.features[i] / sd[i];
+		for (int i = 0; i < n; ++i)
+		{
+			for (int k = 0; k < n; ++k)
+				a[i][k] += z[i] * z[k];
+			b[i] += z[i] * sample.target;
+		}
+	}
+	for (int i = 0; i < n; ++i)
+		a[i][i] += ridge;
+
+	std::vector<double> x;
+	if (!solve(a, b, x))
+		return false;
+
+	for (float &weight : evaluator.weights)
+		weight = 0.0f;
+	for (int i = 0; i < n; ++i)
+		evaluator.weights[i] = sd[i] > 1e-6 ? x[i] / sd[i] : 0.0;
+	return true;
+}
+
+float predict(const StateEvaluator &evaluator, const Sample &sample)
+{
+	float sum = 0;
+	for (int i = 0; i < FEATURES; ++i)
+		sum += evaluator.weights[i] * sample.features[i];
+	return sum;
+}
+
+template <typename Score>
+int getBest(const Decision &decision, Score score)
+{
+	int best = 0;
+	for (int i = 1; i < (int) decision.size(); ++i)
+	{
+		if (score(decision[i]) > score(decision[best]))
+			best = i;
+	}
+	return best;
+}
+
+// R2 of the differences between the candidates of a decision
+void report(const char *name, const std::vector<Decision> &decisions, const StateEvaluator &evaluator)
+{
+	std::vector<Sample> samples;
+	for (const Decision &decision : decisions)
+		center(decision, samples);
+
+	double residual = 0, total = 0;
+	for (const Sample &sample : samples)
+	{
+		double error = predict(evaluator, sample) - sample.target;
+		residual += error * error;
+		total += sample.target * sample.target;
+	}
+
+	int agree = 0, agreeShort = 0;
+	for (const Decision &decision : decisions)
+	{
+
+		int best = getBest(decision, [](const Sample &s) { return s.target; });
+		agree += getBest(decision, [&evaluator](const Sample &s) { return predict(evaluator, s); }) == best;
+		agreeShort += getBest(decision, [](const Sample &s) { return s.shortValue; }) == best;
+	}
+
+	int n = std::max<int>(1, decisions.size());
+	std::cout << "EVALUATOR " << name << " decisions " << decisions.size() << " samples " << samples.size()
+		<< " R2 " << (total > 0 ? 1.0 - residual / total : 0.0)
+		<< " best floor " << 100.0 * agree / n << "% short rollout alone " << 100.0 * agreeShort / n << "%" << std::endl;
+}
+
+}
+
+void runEvaluatorTrainer(const EvaluatorTrainerOptions &trainer, const TournamentOptions &options)
+{
+	std::vector<std::vector<Decision>> games(trainer.games);
+	playGames(trainer.firstGame, trainer.games, [&](int game) {
+		games[game - trainer.firstGame] = collectDecisions(game, trainer.horizon);
+		GameResult result;
+		result.game = game;
+		return result;
+	}, options);
+
+	int validation = std::min(trainer.games - 1, (int) std::lround(trainer.games * trainer.validationShare));
+	std::vector<Decision> train, test;
+	for (int g = 0; g < trainer.games; ++g)
+	{
+		std::vector<Decision> &to = g < trainer.games - validation ? train : test;
+		to.insert(to.end(), games[g].begin(), games[g].end());
+	}
+
+	StateEvaluator evaluator;
+	evaluator.horizon = trainer.horizon;
+	if (!fit(train, trainer.ridge, evaluator))
+	{
+		std::cerr << "Can't fit the evaluator, no samples or singular features" << std::endl;
+		return;
+	}
+
+	report("train", train, evaluator);
+	report("validation", test, evaluator);
+	for (int i = 0; i < StateEvaluator::USED_FEATURES; ++i)
+		std::cout << "WEIGHT " << StateEvaluator::getFeatureName(i) << " " << evaluator.weights[i] << std::endl;
+
+	if (!evaluator.save(trainer.out))
+		std::cerr << "Can't write " << trainer.out << std::endl;
+}
@@ -0,0 +1,26 @@
+#ifndef EVALUATOR_TRAINER_HPP
+#define EVALUATOR_TRAINER_HPP
+
+#include <string>
+#include "Evaluator.hpp"
+#include "Tournament.hpp"
+
+// Offline training of StateEvaluator: MyStrategy plays itself, on every
+// closing tick 98 of either side each candidate floor is rolled out as
+// recalcDestinationBeforeDoorsClose does. The features after horizon ticks
+// are regressed (ridge, standardized features) on getRolloutValue at the
+// full rollout length. The last games are held out to report R2 and how
+// often the best floor by the model is the best by the full rollout.
+struct EvaluatorTrainerOptions
+{
+	int games = 40;
+	int firstGame = 100000;       // away from the game numbers of the arena
+	double validationShare = 0.25;
+	int horizon = StateEvaluator::DEFAULT_HORIZON;
+	double ridge = 1.0;
+	std::string out = "evaluator.txt";
+};
+
+void runEvaluatorTrainer(const EvaluatorTrainerOptions &trainer, const TournamentOptions &options);
+
+#endif
@@ -22,6 +22,9 @@
 
 #endif // ENABLE_LOGGING
 
+// Tick hot paths use the non-blocking LOGE/LOGW/LOGI/LOGD, filtered by LOG_LEVEL
+#include "AsyncLog.hpp"
+
 
 
 
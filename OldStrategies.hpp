@@ -0,0 +1,4905 @@
+#ifndef OLD_STRATEGIES_HPP
+#define OLD_STRATEGIES_HPP
+
+// Archived strategies used as tournament opponents: simple makeMove..makeMove7
+// policies, StratE1..StratE3 and snapshots of MyStrategy at different rating points.
+// Not inline, include from exactly one translation unit per executable.
+
+#include <iostream>
+#include <map>
+#include <set>
+#include <algorithm>
+#include "MyUtils.hpp"
+#include "Strategy.hpp"
+#include "mystrategy.hpp"
+
+void makeMove(Side side, Simulator &sim)
+{
+	for (MyElevator & elevator : sim.elevators)
+	{
+		if (elevator.side == side)
+		{
+			for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+			{
+				MyPassenger &passenger = passengerEntry.second;
+				if (passenger.side == side)
+				{
+					if ((int) passenger.state < 4)
+					{
+						if (elevator.state != EState::MOVING)
+						{
+							elevator.go_to_floor = passenger.from_floor;
+						}
+						if (elevator.getFloor() == passenger.from_floor)
+						{
+							passenger.set_elevator.insert(elevator.id);
+						}
+					}
+				}
+			}
+			
+			if (elevator.passengers.size() > 0 && elevator.state != EState::MOVING) {
+				int delta = 100;
+				int targetFloor = 0;
+				for (int id : elevator.passengers)
+				{
+					MyPassenger &pass = sim.passengers[id];
+					int d = std::abs(elevator.getFloor() - pass.dest_floor);
+					if (d < delta)
+					{
+						delta = d;
+						targetFloor = pass.dest_floor;
+					}
+				}
+				elevator.go_to_floor = targetFloor;
+            }
+		}
+	}
+}
+
+void makeMove2(Side side, Simulator &sim)
+{
+	for (MyElevator & elevator : sim.elevators)
+	{
+		if (elevator.side == side)
+		{
+			for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+			{
+				MyPassenger &passenger = passengerEntry.second;
+				//if (passenger.side == side)
+				{
+					if ((int) passenger.state < 4)
+					{
+						if (elevator.state != EState::MOVING)
+						{
+							elevator.go_to_floor = passenger.from_floor;
+						}
+						if (elevator.getFloor() == passenger.from_floor)
+						{
+							passenger.set_elevator.insert(elevator.id);
+						}
+					}
+				}
+			}
+			
+			if (elevator.passengers.size() > 0 && elevator.state != EState::MOVING) {
+				int delta = 100;
+				int targetFloor = 0;
+				for (int id : elevator.passengers)
+				{
+					MyPassenger &pass = sim.passengers[id];
+					int d = std::abs(elevator.getFloor() - pass.dest_floor);
+					if (d < delta)
+					{
+						delta = d;
+						targetFloor = pass.dest_floor;
+					}
+				}
+				elevator.go_to_floor = targetFloor;
+            }
+            
+            if (elevator.getFloor() == 0 && sim.tick < 2000 && elevator.passengers.size() < 20 || elevator.time_on_the_floor_with_opened_doors < 300 && elevator.passengers.size() < 10)
+				elevator.go_to_floor = -1;
+		}
+	}
+}
+
+void makeMove3(Side side, Simulator &sim)
+{
+	for (MyElevator & elevator : sim.elevators)
+	{
+		if (elevator.side == side)
+		{
+			for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+			{
+				MyPassenger &passenger = passengerEntry.second;
+				int elAbsX = std::abs(elevator.x) ;
+				if (elAbsX < 70 || elAbsX < 150 && passenger.dest_floor < 5 || elAbsX >= 150 && passenger.dest_floor >= 5)
+				{
+					if ((int) passenger.state < 4)
+					{
+						if (elevator.state != EState::MOVING)
+						{
+							elevator.go_to_floor = passenger.from_floor;
+						}
+						if (elevator.getFloor() == passenger.from_floor)
+						{
+							passenger.set_elevator.insert(elevator.id);
+						}
+					}
+				}
+			}
+			
+			if (elevator.passengers.size() > 0 && elevator.state != EState::MOVING) {
+				int delta = 100;
+				int targetFloor = 0;
+				for (int id : elevator.passengers)
+				{
+					MyPassenger &pass = sim.passengers[id];
+					int d = std::abs(elevator.getFloor() - pass.dest_floor);
+					if (d < delta)
+					{
+						delta = d;
+						targetFloor = pass.dest_floor;
+					}
+				}
+				elevator.go_to_floor = targetFloor;
+            }
+            
+            if (elevator.getFloor() == 0 && sim.tick < 2000 && elevator.passengers.size() < 20 || elevator.time_on_the_floor_with_opened_doors < 200 && elevator.passengers.size() < 4)
+				elevator.go_to_floor = -1;
+		}
+	}
+}
+
+void makeMove4(Side side, Simulator &sim)
+{
+	for (MyElevator & elevator : sim.elevators)
+	{
+		if (elevator.side == side)
+		{
+			for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+			{
+				MyPassenger &passenger = passengerEntry.second;
+				int elAbsX = std::abs(elevator.x) ;
+				int ind = 0;
+				if (elAbsX < 70)
+					ind = 0;
+				else if (elAbsX < 150)
+					ind = 1;
+				else if (elAbsX < 230)
+					ind = 2;
+				else
+					ind = 3;
+				
+				int dest_floor = passenger.dest_floor;
+				if (ind == 0 || ind == 1 && dest_floor < 5 || ind == 2 && dest_floor >= 5 || ind == 3 && dest_floor >= 4)
+				{
+					if ((int) passenger.state < 4)
+					{
+						if (elevator.state != EState::MOVING)
+						{
+							elevator.go_to_floor = passenger.from_floor;
+						}
+						if (elevator.getFloor() == passenger.from_floor)
+						{
+							passenger.set_elevator.insert(elevator.id);
+						}
+					}
+				}
+			}
+			
+			if (elevator.passengers.size() > 0 && elevator.state != EState::MOVING) {
+				int delta = 100;
+				int targetFloor = 0;
+				for (int id : elevator.passengers)
+				{
+					MyPassenger &pass = sim.passengers[id];
+					int d = std::abs(elevator.getFloor() - pass.dest_floor);
+					if (d < delta)
+					{
+						delta = d;
+						targetFloor = pass.dest_floor;
+					}
+				}
+				elevator.go_to_floor = targetFloor;
+            }
+            
+            if (elevator.getFloor() == 0 && sim.tick < 2000 && elevator.passengers.size() < 20 || elevator.time_on_the_floor_with_opened_doors < 200 && elevator.passengers.size() < 4)
+				elevator.go_to_floor = -1;
+		}
+	}
+}
+
+void makeMove5(Side side, Simulator &sim)
+{
+	for (MyElevator & elevator : sim.elevators)
+	{
+		if (elevator.side == side)
+		{
+			int elAbsX = std::abs(elevator.x) ;
+            int ind = 0;
+            if (elAbsX < 70)
+                ind = 0;
+            else if (elAbsX < 150)
+                ind = 1;
+            else if (elAbsX < 230)
+                ind = 2;
+            else
+                ind = 3;
+				
+			for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+			{
+				MyPassenger &passenger = passengerEntry.second;
+				
+				int dest_floor = passenger.dest_floor;
+				if (ind == 0 || ind == 1 && dest_floor < 5 || ind == 2 && dest_floor >= 5 || ind == 3 && dest_floor >= 4)
+				{
+					if ((int) passenger.state < 4)
+					{
+						if (elevator.state != EState::MOVING)
+						{
+							elevator.go_to_floor = passenger.from_floor;
+						}
+						if (elevator.getFloor() == passenger.from_floor)
+						{
+							passenger.set_elevator.insert(elevator.id);
+						}
+					}
+				}
+			}
+			
+			if (elevator.passengers.size() > 0 && elevator.state != EState::MOVING) {
+				int delta = 100;
+				int targetFloor = 0;
+				for (int id : elevator.passengers)
+				{
+					MyPassenger &pass = sim.passengers[id];
+					int d = std::abs(elevator.getFloor() - pass.dest_floor);
+					if (d < delta)
+					{
+						delta = d;
+						targetFloor = pass.dest_floor;
+					}
+				}
+				elevator.go_to_floor = targetFloor;
+            }
+            
+            size_t sz = elevator.passengers.size() ;
+			
+			if (elevator.time_on_the_floor_with_opened_doors < 200 && sz < 10)
+				elevator.go_to_floor = -1;
+			
+            //if (elevator.getFloor() == 0 && sim.tick < 2000 && (ind == 0 && sz < 20 || ind > 0 && sz < 20) || elevator.time_on_the_floor_with_opened_doors < 200 && sz < 4)
+			//	elevator.go_to_floor = -1;
+		}
+	}
+}
+
+void makeMove6(Side side, Simulator &sim)
+{
+	for (MyElevator & elevator : sim.elevators)
+	{
+		if (elevator.side == side)
+		{
+			for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+			{
+				MyPassenger &passenger = passengerEntry.second;
+				int elAbsX = std::abs(elevator.x) ;
+				int ind = 0;
+				if (elAbsX < 70)
+					ind = 0;
+				else if (elAbsX < 150)
+					ind = 1;
+				else if (elAbsX < 230)
+					ind = 2;
+				else
+					ind = 3;
+				
+				int dest_floor = passenger.dest_floor;
+				if (ind == 0 && dest_floor >= 7 || ind == 1 && dest_floor >= 5 || ind == 2 && dest_floor >= 4 || ind == 3)
+				{
+					if ((int) passenger.state < 4)
+					{
+						if (elevator.state != EState::MOVING)
+						{
+							elevator.go_to_floor = passenger.from_floor;
+						}
+						if (elevator.getFloor() == passenger.from_floor)
+						{
+							passenger.set_elevator.insert(elevator.id);
+						}
+					}
+				}
+			}
+			
+			if (elevator.passengers.size() > 0 && elevator.state != EState::MOVING) {
+				int delta = 100;
+				int targetFloor = 0;
+				for (int id : elevator.passengers)
+				{
+					MyPassenger &pass = sim.passengers[id];
+					int d = std::abs(elevator.getFloor() - pass.dest_floor);
+					if (d < delta)
+					{
+						delta = d;
+						targetFloor = pass.dest_floor;
+					}
+				}
+				elevator.go_to_floor = targetFloor;
+            }
+            
+            if (elevator.getFloor() == 0 && sim.tick < 2000 && elevator.passengers.size() < 20 || elevator.time_on_the_floor_with_opened_doors < 200 && elevator.passengers.size() < 4)
+				elevator.go_to_floor = -1;
+		}
+	}
+}
+
+void makeMove7(Side side, Simulator &sim)
+{
+	for (MyElevator & elevator : sim.elevators)
+	{
+		if (elevator.side == side)
+		{
+			for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+			{
+				MyPassenger &passenger = passengerEntry.second;
+				int elAbsX = std::abs(elevator.x) ;
+				int ind = 0;
+				if (elAbsX < 70)
+					ind = 0;
+				else if (elAbsX < 150)
+					ind = 1;
+				else if (elAbsX < 230)
+					ind = 2;
+				else
+					ind = 3;
+				
+				int dest_floor = passenger.dest_floor;
+				if (ind == 0 && dest_floor >= 7 || ind == 1 && dest_floor >= 6 || ind == 2 && dest_floor >= 5 || ind == 3 && dest_floor >= 5)
+				{
+					if ((int) passenger.state < 4)
+					{
+						if (elevator.state != EState::MOVING)
+						{
+							elevator.go_to_floor = passenger.from_floor;
+						}
+						if (elevator.getFloor() == passenger.from_floor)
+						{
+							passenger.set_elevator.insert(elevator.id);
+						}
+					}
+				}
+			}
+			
+			if (elevator.passengers.size() > 0 && elevator.state != EState::MOVING) {
+				int delta = 100;
+				int targetFloor = 0;
+				for (int id : elevator.passengers)
+				{
+					MyPassenger &pass = sim.passengers[id];
+					int d = std::abs(elevator.getFloor() - pass.dest_floor);
+					if (d < delta)
+					{
+						delta = d;
+						targetFloor = pass.dest_floor;
+					}
+				}
+				elevator.go_to_floor = targetFloor;
+            }
+            
+            if (elevator.getFloor() == 0 && sim.tick < 2000 && elevator.passengers.size() < 20 || elevator.time_on_the_floor_with_opened_doors < 200 && elevator.passengers.size() < 4)
+				elevator.go_to_floor = -1;
+		}
+	}
+}
+
+int getNearestToLevelDestination(Simulator &sim, MyElevator& elevator, int level);
+
+struct StratE1
+{
+	Side side;
+	Direction dir = Direction::UP;
+	StratE1(Side side) : side(side)
+	{
+	}
+	
+	bool reachedTop = false;
+	void makeMove(Simulator &sim)
+	{
+		for (MyElevator & elevator : sim.elevators)
+		{
+			if (elevator.side == side && elevator.ind == 0)
+			{
+				if (!reachedTop && elevator.getFloor() > 0 && elevator.state == EState::OPENING && getNearestToLevelDestination(sim, elevator, 100) <= elevator.getFloor())
+				{
+					reachedTop = true;
+					dir = Direction::DOWN;
+				}
+				
+				for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+				{
+					MyPassenger &passenger = passengerEntry.second;
+					int dest_floor = passenger.dest_floor;
+					if (elevator.state == EState::FILLING && passenger.getFloor() == elevator.getFloor() && passenger.state == PState::WAITING_FOR_ELEVATOR)
+					if (dir == Direction::UP && passenger.dest_floor > passenger.from_floor || dir == Direction::DOWN && passenger.dest_floor < passenger.from_floor)
+					{
+						if (elevator.state == EState::FILLING && passenger.getFloor() == elevator.getFloor() && passenger.state == PState::WAITING_FOR_ELEVATOR)
+						{
+							if (dir == Direction::UP && sim.tick < 2000 && dest_floor > 7)
+							{
+								if (elevator.passengers.size() < MAX_PASSENGERS)
+								{
+									passenger.set_elevator.insert(elevator.id);
+								}
+							}
+							
+							if (dir == Direction::DOWN && dest_floor <= 4)
+							{
+								if (elevator.passengers.size() < MAX_PASSENGERS)
+								{
+									passenger.set_elevator.insert(elevator.id);
+								}
+							}
+						}
+					}
+				}
+				
+                if (elevator.passengers.size() == MAX_PASSENGERS || elevator.getFloor() > 0 && elevator.getFloor() < (LEVELS_COUNT - 1) ||
+					elevator.getFloor() == (LEVELS_COUNT - 1) && sim.tick > 4000 && elevator.passengers.size() > 15
+				)
+                {
+                    elevator.go_to_floor = getNearestToLevelDestination(sim, elevator, elevator.getFloor());
+                }
+			}
+			else if (elevator.side == side)
+			{
+				for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+				{
+					MyPassenger &passenger = passengerEntry.second;
+					int elAbsX = std::abs(elevator.x) ;
+					int ind = 0;
+					if (elAbsX < 70)
+						ind = 0;
+					else if (elAbsX < 150)
+						ind = 1;
+					else if (elAbsX < 230)
+						ind = 2;
+					else
+						ind = 3;
+					
+					int dest_floor = passenger.dest_floor;
+					if (ind == 0 && dest_floor >= 7 || ind == 1 && dest_floor >= 5 || ind == 2 && dest_floor >= 4 || ind == 3)
+					{
+						if ((int) passenger.state < 4)
+						{
+							if (elevator.state != EState::MOVING)
+							{
+								elevator.go_to_floor = passenger.from_floor;
+							}
+							if (elevator.getFloor() == passenger.from_floor)
+							{
+								passenger.set_elevator.insert(elevator.id);
+							}
+						}
+					}
+				}
+				
+				if (elevator.passengers.size() > 0 && elevator.state != EState::MOVING) {
+					int delta = 100;
+					int targetFloor = 0;
+					for (int id : elevator.passengers)
+					{
+						MyPassenger &pass = sim.passengers[id];
+						int d = std::abs(elevator.getFloor() - pass.dest_floor);
+						if (d < delta)
+						{
+							delta = d;
+							targetFloor = pass.dest_floor;
+						}
+					}
+					elevator.go_to_floor = targetFloor;
+				}
+				
+				if (elevator.getFloor() == 0 && sim.tick < 2000 && elevator.passengers.size() < 20 || elevator.time_on_the_floor_with_opened_doors < 200 && elevator.passengers.size() < 4)
+					elevator.go_to_floor = -1;
+			}
+		}
+	}
+};
+
+struct StratE2
+{
+	Side side;
+	Direction dir = Direction::UP;
+	StratE2(Side side) : side(side)
+	{
+	}
+	
+	bool reachedTop = false;
+	bool reachedTop2 = false;
+	void makeMove(Simulator &sim)
+	{
+		for (MyElevator & elevator : sim.elevators)
+		{
+			if (elevator.side == side && elevator.ind == 0)
+			{
+				if (!reachedTop && elevator.getFloor() > 0 && elevator.state == EState::OPENING && getNearestToLevelDestination(sim, elevator, 100) <= elevator.getFloor())
+				{
+					reachedTop = true;
+					dir = Direction::DOWN;
+				}
+				
+				for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+				{
+					MyPassenger &passenger = passengerEntry.second;
+					int dest_floor = passenger.dest_floor;
+					if (dir == Direction::UP && passenger.dest_floor > passenger.from_floor || dir == Direction::DOWN && passenger.dest_floor < passenger.from_floor)
+					{
+						if (elevator.state == EState::FILLING && passenger.getFloor() == elevator.getFloor() && passenger.state == PState::WAITING_FOR_ELEVATOR)
+						{
+							if (dir == Direction::UP && sim.tick < 2000 && dest_floor > 7)
+							{
+								if (elevator.passengers.size() < MAX_PASSENGERS)
+								{
+									passenger.set_elevator.insert(elevator.id);
+								}
+							}
+							
+							if (dir == Direction::DOWN && dest_floor <= 4)
+							{
+								if (elevator.passengers.size() < MAX_PASSENGERS)
+								{
+									passenger.set_elevator.insert(elevator.id);
+								}
+							}
+						}
+					}
+				}
+				
+                if (elevator.passengers.size() == MAX_PASSENGERS || elevator.getFloor() > 0 && elevator.getFloor() < (LEVELS_COUNT - 1) ||
+					elevator.getFloor() == (LEVELS_COUNT - 1) && sim.tick > 4000 && elevator.passengers.size() > 15 ||
+					sim.tick > 2000 && elevator.getFloor() == 0
+				)
+                {
+                    elevator.go_to_floor = getNearestToLevelDestination(sim, elevator, elevator.getFloor());
+                }
+			}
+			else if (elevator.side == side && elevator.ind == 1)
+			{
+				if (!reachedTop2 && elevator.getFloor() > 0 && elevator.state == EState::OPENING && getNearestToLevelDestination(sim, elevator, 100) <= elevator.getFloor())
+				{
+					reachedTop2 = true;
+					dir = Direction::DOWN;
+				}
+				
+				for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+				{
+					MyPassenger &passenger = passengerEntry.second;
+					int dest_floor = passenger.dest_floor;
+					if (dir == Direction::UP && passenger.dest_floor > passenger.from_floor || dir == Direction::DOWN && passenger.dest_floor < passenger.from_floor)
+					{
+						if (elevator.state == EState::FILLING && passenger.getFloor() == elevator.getFloor() && passenger.state == PState::WAITING_FOR_ELEVATOR)
+						{
+							if (dir == Direction::UP && sim.tick < 2000 && dest_floor > 6 && dest_floor < 8)
+							{
+								if (elevator.passengers.size() < MAX_PASSENGERS)
+								{
+									passenger.set_elevator.insert(elevator.id);
+								}
+							}
+							
+							if (dir == Direction::DOWN && dest_floor <= 3)
+							{
+								if (elevator.passengers.size() < MAX_PASSENGERS)
+								{
+									passenger.set_elevator.insert(elevator.id);
+								}
+							}
+						}
+					}
+				}
+				
+                if (elevator.passengers.size() == MAX_PASSENGERS || elevator.getFloor() > 0 && elevator.getFloor() < (LEVELS_COUNT - 2) ||
+					elevator.getFloor() == (LEVELS_COUNT - 2) && sim.tick > 3800 && elevator.passengers.size() > 15 ||
+					sim.tick > 2000 && elevator.getFloor() == 0
+				)
+                {
+                    elevator.go_to_floor = getNearestToLevelDestination(sim, elevator, elevator.getFloor());
+                }
+			}
+			else if (elevator.side == side)
+			{
+				for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+				{
+					MyPassenger &passenger = passengerEntry.second;
+					int elAbsX = std::abs(elevator.x) ;
+					int ind = 0;
+					if (elAbsX < 70)
+						ind = 0;
+					else if (elAbsX < 150)
+						ind = 1;
+					else if (elAbsX < 230)
+						ind = 2;
+					else
+						ind = 3;
+					
+					int dest_floor = passenger.dest_floor;
+					if (ind == 0 && dest_floor >= 7 || ind == 1 && dest_floor >= 5 || ind == 2 && dest_floor >= 4 || ind == 3)
+					{
+						if ((int) passenger.state < 4)
+						{
+							if (elevator.state != EState::MOVING)
+							{
+								elevator.go_to_floor = passenger.from_floor;
+							}
+							if (elevator.getFloor() == passenger.from_floor)
+							{
+								passenger.set_elevator.insert(elevator.id);
+							}
+						}
+					}
+				}
+				
+				if (elevator.passengers.size() > 0 && elevator.state != EState::MOVING) {
+					int delta = 100;
+					int targetFloor = 0;
+					for (int id : elevator.passengers)
+					{
+						MyPassenger &pass = sim.passengers[id];
+						int d = std::abs(elevator.getFloor() - pass.dest_floor);
+						if (d < delta)
+						{
+							delta = d;
+							targetFloor = pass.dest_floor;
+						}
+					}
+					elevator.go_to_floor = targetFloor;
+				}
+				
+				if (elevator.getFloor() == 0 && sim.tick < 2000 && elevator.passengers.size() < 20 || elevator.time_on_the_floor_with_opened_doors < 200 && elevator.passengers.size() < 4)
+					elevator.go_to_floor = -1;
+			}
+		}
+	}
+};
+
+struct StratE3
+{
+	Side side;
+	Direction dir = Direction::UP;
+	StratE3(Side side) : side(side)
+	{
+	}
+	
+	bool reachedTop = false;
+	bool reachedTop2 = false;
+	int maxFloor1 = LEVELS_COUNT - 1;
+	int maxFloor2 = LEVELS_COUNT - 2;
+	void makeMove(Simulator &sim)
+	{
+		for (MyElevator & elevator : sim.elevators)
+		{
+			if (elevator.side == side && elevator.ind == 0)
+			{
+				if (!reachedTop && elevator.getFloor() > 0 && elevator.state == EState::OPENING && getNearestToLevelDestination(sim, elevator, 100) <= elevator.getFloor())
+				{
+					reachedTop = true;
+					dir = Direction::DOWN;
+					maxFloor1 = elevator.getFloor();
+				}
+				
+				for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+				{
+					MyPassenger &passenger = passengerEntry.second;
+					int dest_floor = passenger.dest_floor;
+					if (dir == Direction::UP && passenger.dest_floor > passenger.from_floor || dir == Direction::DOWN && passenger.dest_floor < passenger.from_floor)
+					{
+						if (elevator.state == EState::FILLING && passenger.getFloor() == elevator.getFloor() && passenger.state == PState::WAITING_FOR_ELEVATOR)
+						{
+							if (dir == Direction::UP && sim.tick < 2000 && dest_floor > 6)
+							{
+								if (elevator.passengers.size() < MAX_PASSENGERS)
+								{
+									passenger.set_elevator.insert(elevator.id);
+								}
+							}
+							
+							if (dir == Direction::DOWN && dest_floor <= 4)
+							{
+								if (elevator.passengers.size() < MAX_PASSENGERS)
+								{
+									passenger.set_elevator.insert(elevator.id);
+								}
+							}
+						}
+					}
+				}
+				
+                if (elevator.passengers.size() == MAX_PASSENGERS || elevator.getFloor() > 0 && elevator.getFloor() < maxFloor1 ||
+					elevator.getFloor() == maxFloor1 && sim.tick > 4600 && elevator.passengers.size() >= 10 ||
+					sim.tick > 2000 && elevator.getFloor() == 0
+				)
+                {
+                    elevator.go_to_floor = getNearestToLevelDestination(sim, elevator, elevator.getFloor());
+                }
+			}
+			else if (elevator.side == side && elevator.ind == 1)
+			{
+				if (!reachedTop2 && elevator.getFloor() > 0 && elevator.state == EState::OPENING && getNearestToLevelDestination(sim, elevator, 100) <= elevator.getFloor())
+				{
+					reachedTop2 = true;
+					dir = Direction::DOWN;
+					maxFloor2 = elevator.getFloor();
+				}
+				
+				for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+				{
+					MyPassenger &passenger = passengerEntry.second;
+					int dest_floor = passenger.dest_floor;
+					if (dir == Direction::UP && passenger.dest_floor > passenger.from_floor || dir == Direction::DOWN && passenger.dest_floor < passenger.from_floor)
+					{
+						if (elevator.state == EState::FILLING && passenger.getFloor() == elevator.getFloor() && passenger.state == PState::WAITING_FOR_ELEVATOR)
+						{
+							if (dir == Direction::UP && sim.tick < 2000 && dest_floor > 5 && dest_floor < 8)
+							{
+								if (elevator.passengers.size() < MAX_PASSENGERS)
+								{
+									passenger.set_elevator.insert(elevator.id);
+								}
+							}
+							
+							if (dir == Direction::DOWN && dest_floor <= 3)
+							{
+								if (elevator.passengers.size() < MAX_PASSENGERS)
+								{
+									passenger.set_elevator.insert(elevator.id);
+								}
+							}
+						}
+					}
+				}
+				
+                if (elevator.passengers.size() == MAX_PASSENGERS || elevator.getFloor() > 0 && elevator.getFloor() < maxFloor2 ||
+					elevator.getFloor() == maxFloor2 && sim.tick > 4600 && elevator.passengers.size() >= 10 ||
+					sim.tick > 2000 && elevator.getFloor() == 0
+				)
+                {
+                    elevator.go_to_floor = getNearestToLevelDestination(sim, elevator, elevator.getFloor());
+                }
+			}
+			else if (elevator.side == side)
+			{
+				for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+				{
+					MyPassenger &passenger = passengerEntry.second;
+					int elAbsX = std::abs(elevator.x) ;
+					int ind = 0;
+					if (elAbsX < 70)
+						ind = 0;
+					else if (elAbsX < 150)
+						ind = 1;
+					else if (elAbsX < 230)
+						ind = 2;
+					else
+						ind = 3;
+					
+					int dest_floor = passenger.dest_floor;
+					if (ind == 0 && dest_floor >= 7 || ind == 1 && dest_floor >= 5 || ind == 2 && dest_floor >= 4 || ind == 3)
+					{
+						if ((int) passenger.state < 4)
+						{
+							if (elevator.state != EState::MOVING)
+							{
+								elevator.go_to_floor = passenger.from_floor;
+							}
+							if (elevator.getFloor() == passenger.from_floor)
+							{
+								passenger.set_elevator.insert(elevator.id);
+							}
+						}
+					}
+				}
+				
+				if (elevator.passengers.size() > 0 && elevator.state != EState::MOVING) {
+					int delta = 100;
+					int targetFloor = 0;
+					for (int id : elevator.passengers)
+					{
+						MyPassenger &pass = sim.passengers[id];
+						int d = std::abs(elevator.getFloor() - pass.dest_floor);
+						if (d < delta)
+						{
+							delta = d;
+							targetFloor = pass.dest_floor;
+						}
+					}
+					elevator.go_to_floor = targetFloor;
+				}
+				
+				if (elevator.getFloor() == 0 && sim.tick < 2000 && elevator.passengers.size() < 20 || elevator.time_on_the_floor_with_opened_doors < 200 && elevator.passengers.size() < 4)
+					elevator.go_to_floor = -1;
+			}
+		}
+	}
+};
+
+namespace strat2661 {
+	enum class Direction {
+    UP, DOWN
+};
+
+int getNearestToLevelDestination(Simulator &sim, MyElevator& elevator, int level);
+int getNearestToLevelDestinationNoRand(Simulator &sim, MyElevator& elevator, int level);
+
+struct Value {
+	int points = 0;
+	int ticks = 0;
+};
+
+struct ElevatorStrategyUpDown
+{
+	Side side;
+	Direction dir = Direction::UP;
+	int dirChanges = 0;
+	int firstMoveMinDest = 0;
+	
+	void makeMove(Simulator &sim, MyElevator &elevator)
+	{
+		Direction old = dir;
+		doMakeMove(sim, elevator);
+		if (old != dir)
+			++dirChanges;
+	}
+	
+	void doMakeMove(Simulator &sim, MyElevator &elevator)
+	{
+		if (dir == Direction::UP && elevator.getFloor() == (LEVELS_COUNT - 1))
+			dir = Direction::DOWN;
+		else if (dir == Direction::DOWN && elevator.getFloor() == 0)
+			dir = Direction::UP;
+		
+		if (elevator.state != EState::FILLING)
+			return;
+		
+		Value value = getCargoValue(sim, elevator);
+		
+		int floor = elevator.getFloor();
+		
+		if (elevator.passengers.size() == MAX_PASSENGERS)
+		{
+			int go_to_floor = strat2661::getNearestToLevelDestinationNoRand(sim, elevator, elevator.getFloor());
+			goToFloor(elevator, go_to_floor);
+		}
+		
+		int passCount = invitePassengers(sim, elevator);
+		if (sim.tick < 1980 && floor == 0)
+			++passCount;
+        
+        if (!passCount)
+		{
+			//int maxWait = 300 - std::max(0, (int) (elevator.passengers.size()) - 12) * 25;
+			int maxWait = 550 - std::max(0, (int) (elevator.passengers.size()) - 12) * 50;
+			int ticksToWait = std::min(std::max(0, 7200 - sim.tick - value.ticks), maxWait);
+			//std::cout << "Wait " << ticksToWait << std::endl;
+			for (auto && p = sim.outPassengers.begin(); p != sim.outPassengers.upper_bound(sim.tick + ticksToWait); ++p)
+			{
+				if (p->second.getFloor() == floor)
+					++passCount;
+			}
+		}
+		
+		if (!passCount)
+		{
+			int go_to_floor = strat2661::getNearestToLevelDestinationNoRand(sim, elevator, elevator.getFloor());
+			if (go_to_floor != floor)
+			{
+				goToFloor(elevator, go_to_floor);
+			}
+			else
+			{
+				// TODO
+				if (dir == Direction::UP)
+					goToFloor(elevator, floor + 1);
+				else
+					goToFloor(elevator, floor - 1);
+			}
+		}
+	}
+	
+	void goToFloor(MyElevator &elevator, int go_to_floor)
+	{
+        if (go_to_floor > elevator.getFloor())
+            dir = Direction::UP;
+        else
+            dir = Direction::DOWN;
+        elevator.go_to_floor = go_to_floor;
+	}
+	
+	int invitePassengers(Simulator &sim, MyElevator &elevator)
+	{
+		int passCount = 0;
+		int floor = elevator.getFloor();
+		for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+        {
+            MyPassenger &passenger = passengerEntry.second;
+            int dest_floor = passenger.dest_floor;
+			
+            //if (dir == Direction::UP && passenger.dest_floor > passenger.from_floor || dir == Direction::DOWN && passenger.dest_floor < passenger.from_floor)
+            {
+				if (floor == 0 && dirChanges == 0 && dest_floor <= firstMoveMinDest && sim.tick < 1980)
+					continue;
+				
+                if (passenger.getFloor() == floor)
+				{
+					if (passenger.state == PState::WAITING_FOR_ELEVATOR || passenger.state == PState::RETURNING)
+					{
+						++passCount;
+						passenger.set_elevator.insert(elevator.id);
+					}
+					else if (passenger.state == PState::MOVING_TO_ELEVATOR && passenger.elevator == elevator.id)
+					{
+						++passCount;
+					}
+				}
+            }
+        }
+        
+        return passCount;
+	}
+	
+	Value getCargoValue(Simulator &sim, MyElevator &elevator)
+	{
+		Value result;
+		
+		std::bitset<LEVELS_COUNT> levels;
+		levels.set(0);
+		
+		int minFloor = elevator.getFloor();
+		int maxFloor = minFloor;
+		int floor = elevator.getFloor();
+		for (int id : elevator.passengers)
+		{
+			MyPassenger &pass = sim.passengers[id];
+			result.points += std::abs(pass.dest_floor - pass.from_floor) * 10;
+			minFloor = std::min(minFloor, pass.dest_floor);
+			maxFloor = std::max(maxFloor, pass.dest_floor);
+			if (pass.dest_floor != floor)
+			{
+				levels.set(pass.dest_floor);
+			}
+		}
+		
+		result.ticks = (maxFloor - minFloor + std::min(maxFloor - floor, floor - minFloor)) * 10 * 60 + levels.size() * 250;
+		
+		return result;
+	}
+};
+
+class MyStrategy
+{
+public:
+	Side side;
+	Simulator sim;
+	ElevatorStrategyUpDown strategy1;
+	ElevatorStrategyUpDown strategy2;
+	ElevatorStrategyUpDown strategy3;
+	ElevatorStrategyUpDown strategy4;
+
+    MyStrategy(Side side);
+    ~MyStrategy();
+	
+	void makeMove(Simulator &inputSim);
+	void makeMove();
+};
+
+int getNearestToLevelDestinationNoRand(Simulator &sim, MyElevator& elevator, int level)
+{
+    int delta = 1000;
+    int targetFloor = level;
+
+	std::map<int, int> points;
+	
+    for (int id : elevator.passengers)
+    {
+        MyPassenger &pass = sim.passengers[id];
+		int d = -std::abs(pass.dest_floor - pass.from_floor);
+		points[pass.dest_floor] += d;
+    }
+    
+    auto x = std::min_element(points.begin(), points.end(),
+    [level](const std::pair<int, int>& p1, const std::pair<int, int>& p2) {
+        return (p1.second + 7*std::abs(level - p1.first)) < (p2.second + 7*std::abs(level - p2.first)); });
+
+	if (x != points.end())
+		return x->first;
+	
+    return targetFloor;
+}
+
+MyStrategy::MyStrategy(Side side) : side(side)
+{
+	strategy1.side = side;
+	strategy2.side = side;
+	strategy3.side = side;
+	strategy4.side = side;
+	
+	strategy1.firstMoveMinDest = 6;
+	strategy2.firstMoveMinDest = 5;
+	strategy3.firstMoveMinDest = 3;
+	strategy4.firstMoveMinDest = 2;
+}
+
+MyStrategy::~MyStrategy()
+{
+
+}
+
+void MyStrategy::makeMove()
+{
+	for (MyElevator & elevator : sim.elevators)
+    {
+        if (elevator.side == side && elevator.ind == 0)
+        {
+			strategy1.makeMove(sim, elevator);
+        }
+        else if (elevator.side == side && elevator.ind == 1)
+        {
+			strategy2.makeMove(sim, elevator);
+        }
+        else if (elevator.side == side && elevator.ind == 2)
+        {
+			strategy3.makeMove(sim, elevator);
+        }
+        else if (elevator.side == side && elevator.ind == 3)
+        {
+			strategy4.makeMove(sim, elevator);
+		}
+    }
+}
+
+void MyStrategy::makeMove(Simulator &inputSim)
+{
+    sim.synchronizeWith(inputSim);
+    makeMove();
+    inputSim.copyCommandsFrom(sim, side);
+    sim.step();
+}
+
+}
+
+namespace strat2724 {
+	#include <bitset>
+#include <iostream>
+
+enum class Direction {
+    UP, DOWN
+};
+
+int getNearestToLevelDestination(Simulator &sim, MyElevator& elevator, int level);
+int getNearestToLevelDestinationNoRand(Simulator &sim, MyElevator& elevator, int level);
+
+class MyStrategy;
+struct ElevatorStrategyUpDown
+{
+	Side side;
+	Direction dir = Direction::UP;
+	int dirChanges = 0;
+	int firstMoveMinDest = 0;
+	bool doPredictions = true;
+	
+	void makeMove(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+	{
+		Direction old = dir;
+		doMakeMove(sim, elevator, strategy);
+		if (old != dir)
+			++dirChanges;
+	}
+	
+	void doMakeMove(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+	{
+		if (dir == Direction::UP && elevator.getFloor() == (LEVELS_COUNT - 1))
+			dir = Direction::DOWN;
+		else if (dir == Direction::DOWN && elevator.getFloor() == 0)
+			dir = Direction::UP;
+		
+		if (doPredictions && elevator.state == EState::CLOSING && elevator.closing_or_opening_ticks == 98)
+		{
+			recalcDestinationBeforeDoorsClose(sim, elevator, strategy);
+			return;
+		}
+		
+		if (elevator.state != EState::FILLING)
+			return;
+		
+		Value value = sim.getCargoValue(elevator);
+		
+		int floor = elevator.getFloor();
+		
+		if (elevator.passengers.size() == MAX_PASSENGERS)
+		{
+			int go_to_floor = strat2724::getNearestToLevelDestinationNoRand(sim, elevator, elevator.getFloor());
+			goToFloor(elevator, go_to_floor);
+		}
+		
+		int passCount = invitePassengers(sim, elevator);
+		if (sim.tick < 1980 && floor == 0)
+			++passCount;
+        
+		bool anyElevatorsCloserThanMe = false;
+		for (MyElevator &otherEl : sim.elevators)
+		{
+			if (otherEl.side == side && otherEl.state == EState::FILLING && otherEl.getFloor() == floor && otherEl.ind < elevator.ind)
+			{
+				anyElevatorsCloserThanMe = true;
+				break;
+			}
+		}
+		
+        if (!passCount)
+		{
+			//int maxWait = 300 - std::max(0, (int) (elevator.passengers.size()) - 12) * 25;
+			int maxWait = 550 - std::max(0, (int) (elevator.passengers.size()) - 12) * 50;
+			int ticksToWait = std::min(std::max(0, 7200 - sim.tick - value.ticks), maxWait);
+			//std::cout << "Wait " << ticksToWait << std::endl;
+			for (auto && p = sim.outPassengers.begin(); p != sim.outPassengers.upper_bound(sim.tick + ticksToWait); ++p)
+			{
+				if (p->second.getFloor() == floor)
+					++passCount;
+			}
+		}
+		
+		if (!passCount)
+		{
+			int go_to_floor = strat2724::getNearestToLevelDestinationNoRand(sim, elevator, elevator.getFloor());
+			if (go_to_floor != floor)
+			{
+				goToFloor(elevator, go_to_floor);
+			}
+			else
+			{
+				// TODO
+				if (dir == Direction::UP)
+					goToFloor(elevator, floor + 1);
+				else
+					goToFloor(elevator, floor - 1);
+			}
+		}
+	}
+	
+	void recalcDestinationBeforeDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy);
+	
+	void goToFloor(MyElevator &elevator, int go_to_floor)
+	{
+        if (go_to_floor > elevator.getFloor())
+            dir = Direction::UP;
+        else
+            dir = Direction::DOWN;
+        elevator.go_to_floor = go_to_floor;
+	}
+	
+	int invitePassengers(Simulator &sim, MyElevator &elevator)
+	{
+		int passCount = 0;
+		int floor = elevator.getFloor();
+		for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+        {
+            MyPassenger &passenger = passengerEntry.second;
+            int dest_floor = passenger.dest_floor;
+			
+            //if (dir == Direction::UP && passenger.dest_floor > passenger.from_floor || dir == Direction::DOWN && passenger.dest_floor < passenger.from_floor)
+            {
+				if (floor == 0 && dirChanges == 0 && dest_floor <= firstMoveMinDest && sim.tick < 1980)
+					continue;
+				
+                if (passenger.getFloor() == floor)
+				{
+					if (passenger.state == PState::WAITING_FOR_ELEVATOR || passenger.state == PState::RETURNING)
+					{
+						++passCount;
+						passenger.set_elevator.insert(elevator.id);
+					}
+					else if (passenger.state == PState::MOVING_TO_ELEVATOR && passenger.elevator == elevator.id)
+					{
+						++passCount;
+					}
+				}
+            }
+        }
+        
+        return passCount;
+	}
+};
+
+class MyStrategy
+{
+public:
+	Side side;
+	Simulator sim;
+	ElevatorStrategyUpDown strategy1;
+	ElevatorStrategyUpDown strategy2;
+	ElevatorStrategyUpDown strategy3;
+	ElevatorStrategyUpDown strategy4;
+
+    MyStrategy(Side side);
+    ~MyStrategy();
+	
+	void makeMove(Simulator &inputSim);
+	void makeMove();
+};
+
+#ifndef HEADER_OLNY_INLINE
+#define HEADER_OLNY_INLINE
+#define HEADER_OLNY_STATIC
+#endif
+
+HEADER_OLNY_INLINE void makeMoveSimple(Side side, Simulator &sim)
+{
+	for (MyElevator & elevator : sim.elevators)
+	{
+		if (elevator.side == side)
+		{
+			for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+			{
+				MyPassenger &passenger = passengerEntry.second;
+				int elAbsX = std::abs(elevator.x) ;
+				if (elAbsX < 70 || elAbsX < 150 && passenger.dest_floor < 5 || elAbsX >= 150 && passenger.dest_floor >= 5)
+				{
+					if ((int) passenger.state < 4)
+					{
+						if (elevator.state != EState::MOVING)
+						{
+							elevator.go_to_floor = passenger.from_floor;
+						}
+						if (elevator.getFloor() == passenger.from_floor)
+						{
+							passenger.set_elevator.insert(elevator.id);
+						}
+					}
+				}
+			}
+			
+			if (elevator.passengers.size() > 0 && elevator.state != EState::MOVING) {
+				int delta = 100;
+				int targetFloor = 0;
+				for (int id : elevator.passengers)
+				{
+					MyPassenger &pass = sim.passengers[id];
+					int d = std::abs(elevator.getFloor() - pass.dest_floor);
+					if (d < delta)
+					{
+						delta = d;
+						targetFloor = pass.dest_floor;
+					}
+				}
+				elevator.go_to_floor = targetFloor;
+            }
+            
+            if (elevator.getFloor() == 0 && sim.tick < 2000 && elevator.passengers.size() < 20 || elevator.time_on_the_floor_with_opened_doors < 200 && elevator.passengers.size() < 4)
+				elevator.go_to_floor = -1;
+		}
+	}
+}
+
+
+HEADER_OLNY_INLINE int getNearestToLevelDestination(Simulator &sim, MyElevator& elevator, int level)
+{
+    int delta = 1000;
+    int targetFloor = level;
+    for (int id : elevator.passengers)
+    {
+        MyPassenger &pass = sim.passengers[id];
+        int d = std::abs(level - pass.dest_floor);
+        if (d < delta)
+        {
+            delta = d;
+            targetFloor = pass.dest_floor;
+        }
+    }
+    
+    if (targetFloor == level)
+	{
+		return rand() % 8 + 1;
+	}
+
+    return targetFloor;
+}
+
+HEADER_OLNY_INLINE int getNearestToLevelDestinationNoRand(Simulator &sim, MyElevator& elevator, int level)
+{
+    int targetFloor = level;
+
+	std::map<int, int> points;
+	
+    for (int id : elevator.passengers)
+    {
+        MyPassenger &pass = sim.passengers[id];
+		int d = -std::abs(pass.dest_floor - pass.from_floor);
+		points[pass.dest_floor] += d;
+    }
+
+    auto x = std::min_element(points.begin(), points.end(),
+    [level](const std::pair<int, int>& p1, const std::pair<int, int>& p2) {
+        return (p1.second + 7*std::abs(level - p1.first)) < (p2.second + 7*std::abs(level - p2.first)); });
+
+	if (x != points.end())
+		return x->first;
+	
+    return targetFloor;
+}
+
+HEADER_OLNY_INLINE MyStrategy::MyStrategy(Side side) : side(side)
+{
+	strategy1.side = side;
+	strategy2.side = side;
+	strategy3.side = side;
+	strategy4.side = side;
+	
+	strategy1.firstMoveMinDest = 6;
+	strategy2.firstMoveMinDest = 5;
+	strategy3.firstMoveMinDest = 3;
+	strategy4.firstMoveMinDest = 2;
+}
+
+HEADER_OLNY_INLINE MyStrategy::~MyStrategy()
+{
+
+}
+
+HEADER_OLNY_INLINE void MyStrategy::makeMove()
+{
+	for (MyElevator & elevator : sim.elevators)
+    {
+        if (elevator.side == side && elevator.ind == 0)
+        {
+			strategy1.makeMove(sim, elevator, this);
+        }
+        else if (elevator.side == side && elevator.ind == 1)
+        {
+			strategy2.makeMove(sim, elevator, this);
+        }
+        else if (elevator.side == side && elevator.ind == 2)
+        {
+			strategy3.makeMove(sim, elevator, this);
+        }
+        else if (elevator.side == side && elevator.ind == 3)
+        {
+			strategy4.makeMove(sim, elevator, this);
+		}
+    }
+}
+
+HEADER_OLNY_INLINE void MyStrategy::makeMove(Simulator &inputSim)
+{
+    sim.synchronizeWith(inputSim);
+    makeMove();
+    inputSim.copyCommandsFrom(sim, side);
+    sim.step();
+}
+
+HEADER_OLNY_INLINE void ElevatorStrategyUpDown::recalcDestinationBeforeDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+{
+	int res = -100000;
+	int targetFloor = -1;
+	
+	Side enemySide = inverseSide(strategy->side);
+	for (int i = 0; i < LEVELS_COUNT; ++i)
+	{
+		if (i != elevator.getFloor())
+		{
+			MyStrategy copy = *strategy;
+			copy.strategy1.doPredictions = false;
+			copy.strategy2.doPredictions = false;
+			copy.strategy3.doPredictions = false;
+			copy.strategy4.doPredictions = false;
+			
+			MyElevator &el = copy.sim.elevators[elevator.id];
+			el.go_to_floor = i;
+			
+			for (int tick = 0; tick < 400; ++tick)
+			{
+				//makeMoveSimple(enemySide, copy.sim);
+				copy.makeMove();
+				copy.sim.step();
+			}
+			
+			int valLeft = copy.sim.scores[0] + copy.sim.totalCargoValue(Side::LEFT).points / 2;
+			int valRight = copy.sim.scores[1] + copy.sim.totalCargoValue(Side::RIGHT).points / 2;
+			// 1000 ticks
+			// /3 RES: 1.09252 8088.1 8836.4 W 78 L 22 GOOD!
+			// /1.5 RES: 1.09848 8163.4 8967.3 W 80 L 20 GOOD!
+			// /2 RES: 1.10654 8272 9153.3 W 84 L 16 GOOD!!
+			// 500 ticks
+			// 300 RES: 1.13074 8058.8 9112.4 W 85 L 15 GOOD!!
+			// 400 RES: 1.21191 7952.8 9638.1 W 93 L 7 GOOD!!!!
+			// 500 RES: 1.17981 8093.7 9549 W 92 L 8 GOOD!!
+			// 600 RES: 1.16856 7998.3 9346.5 W 90 L 10 GOOD!!
+			// 700 RES: 1.17386 7896.1 9268.9 W 89 L 11 GOOD!!
+			// 400/2 RES: 1.21191 7952.8 9638.1 W 93 L 7 GOOD!!!!
+			// 400/1.7 RES: 1.19318 7929.3 9461.1 W 89 L 11 GOOD!!
+			// 400/2.2 RES: 1.1988 7974 9559.2 W 91 L 9 GOOD!!
+			
+			int points;
+			if (copy.side == Side::LEFT)
+				points = valLeft - valRight;
+			else
+				points = valRight - valLeft;
+			
+			//std::cout << "PTS " << i << " " << valLeft << " " << valRight << " " << points << std::endl;
+			if (i == elevator.next_floor)
+				++points;
+			if (points > res)
+			{
+				res = points;
+				targetFloor = i;
+			}
+		}
+	}
+	
+	if (targetFloor != -1)
+	{
+		int prevTarget = elevator.next_floor;
+		elevator.go_to_floor = targetFloor;
+		//std::cout << " Target " << targetFloor << " OLD " << prevTarget << std::endl;
+	}
+}
+}
+
+
+namespace strat2806 {
+	enum class Direction {
+    UP, DOWN
+};
+
+int getNearestToLevelDestination(Simulator &sim, MyElevator& elevator, int level);
+int getNearestToLevelDestinationNoRand(Simulator &sim, MyElevator& elevator, int level);
+
+class MyStrategy;
+struct ElevatorStrategyUpDown
+{
+	Side side;
+	Direction dir = Direction::UP;
+	int dirChanges = 0;
+	int firstMoveMinDest = 0;
+	bool doPredictions = true;
+	
+	void makeMove(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+	{
+		Direction old = dir;
+		doMakeMove(sim, elevator, strategy);
+		if (old != dir)
+			++dirChanges;
+	}
+	
+	void doMakeMove(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+	{
+		if (dir == Direction::UP && elevator.getFloor() == (LEVELS_COUNT - 1))
+			dir = Direction::DOWN;
+		else if (dir == Direction::DOWN && elevator.getFloor() == 0)
+			dir = Direction::UP;
+		
+		if (doPredictions && elevator.state == EState::CLOSING && elevator.closing_or_opening_ticks == 98)
+		{
+			recalcDestinationBeforeDoorsClose(sim, elevator, strategy);
+			return;
+		}
+		
+		if (elevator.state != EState::FILLING)
+			return;
+		
+		Value value = sim.getCargoValue(elevator);
+		
+		int floor = elevator.getFloor();
+		
+		if (elevator.passengers.size() == MAX_PASSENGERS)
+		{
+			int go_to_floor = strat2806::getNearestToLevelDestinationNoRand(sim, elevator, elevator.getFloor());
+			goToFloor(elevator, go_to_floor);
+		}
+		
+		int passCount = invitePassengers(sim, elevator);
+		if (sim.tick < 1980 && floor == 0)
+			++passCount;
+        
+		bool anyElevatorsCloserThanMe = false;
+		for (MyElevator &otherEl : sim.elevators)
+		{
+			if (otherEl.side == side && otherEl.state == EState::FILLING && otherEl.getFloor() == floor && otherEl.ind < elevator.ind)
+			{
+				anyElevatorsCloserThanMe = true;
+				break;
+			}
+		}
+		
+        if (!passCount)
+		{
+			//int maxWait = 300 - std::max(0, (int) (elevator.passengers.size()) - 12) * 25;
+			int maxWait = 550 - std::max(0, (int) (elevator.passengers.size()) - 12) * 50;
+			int ticksToWait = std::min(std::max(0, 7200 - sim.tick - value.ticks), maxWait);
+			//std::cout << "Wait " << ticksToWait << std::endl;
+			for (auto && p = sim.outPassengers.begin(); p != sim.outPassengers.upper_bound(sim.tick + ticksToWait); ++p)
+			{
+				if (p->second.getFloor() == floor)
+					++passCount;
+			}
+		}
+		
+		if (!passCount)
+		{
+			int go_to_floor = strat2806::getNearestToLevelDestinationNoRand(sim, elevator, elevator.getFloor());
+			if (go_to_floor != floor)
+			{
+				goToFloor(elevator, go_to_floor);
+			}
+			else
+			{
+				// TODO
+				if (dir == Direction::UP)
+					goToFloor(elevator, floor + 1);
+				else
+					goToFloor(elevator, floor - 1);
+			}
+		}
+	}
+	
+	void recalcDestinationBeforeDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy);
+	
+	void goToFloor(MyElevator &elevator, int go_to_floor)
+	{
+        if (go_to_floor > elevator.getFloor())
+            dir = Direction::UP;
+        else
+            dir = Direction::DOWN;
+        elevator.go_to_floor = go_to_floor;
+	}
+	
+	int invitePassengers(Simulator &sim, MyElevator &elevator)
+	{
+		int passCount = 0;
+		int floor = elevator.getFloor();
+		
+		bool anyElevatorsCloser = false;
+		/*for (MyElevator &e : sim.elevators)
+		{
+			if (e.id != elevator.id && e.ind <= elevator.ind && e.state == EState::FILLING && e.getFloor() == floor && e.side != elevator.side)
+			{
+				anyElevatorsCloser = true;
+				break;
+			}
+		}*/
+		
+		//std::bitset<LEVELS_COUNT> levels;
+		
+		std::multimap<int, MyPassenger *> passengers;
+		
+		for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+        {
+            MyPassenger &passenger = passengerEntry.second;
+            int dest_floor = passenger.dest_floor;
+			
+            //if (elevator.ind < 3 || dir == Direction::UP && passenger.dest_floor > passenger.from_floor || dir == Direction::DOWN && passenger.dest_floor < passenger.from_floor)
+            {
+				if (floor == 0 && dirChanges == 0 && dest_floor <= firstMoveMinDest && sim.tick < 1980)
+					continue;
+				
+                if (passenger.getFloor() == floor)
+				{
+					if (passenger.state == PState::WAITING_FOR_ELEVATOR || passenger.state == PState::RETURNING)
+					{
+						if (anyElevatorsCloser)
+						{
+							passenger.set_elevator.insert(elevator.id);
+							++passCount;
+						}
+						else
+						{
+							passengers.insert(std::make_pair(passenger.getValue(side), &passenger));
+						}
+					}
+					else if (passenger.state == PState::MOVING_TO_ELEVATOR && passenger.elevator == elevator.id)
+					{
+						++passCount;
+						//levels.set(dest_floor);
+					}
+				}
+            }
+        }
+		
+		if (!anyElevatorsCloser)
+		{
+			int limit = MAX_PASSENGERS - (int) elevator.passengers.size() - passCount;
+			//std::cout << "LIMIT " << limit << " " << passengers.size() << std::endl;
+			
+			for (auto it = passengers.rbegin(); it != passengers.rend(); ++it)
+			{
+				if (limit <= 0)
+					break;
+				
+				if (limit <= 2 && it->first < 30 || limit <= 4 && it->first < 20)
+					continue;
+				
+				it->second->set_elevator.insert(elevator.id);
+				++passCount;
+				
+				--limit;
+			}
+		}
+		
+        return passCount;
+	}
+};
+
+class MyStrategy
+{
+public:
+	Side side;
+	Simulator sim;
+	ElevatorStrategyUpDown strategy1;
+	ElevatorStrategyUpDown strategy2;
+	ElevatorStrategyUpDown strategy3;
+	ElevatorStrategyUpDown strategy4;
+
+    MyStrategy(Side side);
+    ~MyStrategy();
+	
+	void makeMove(Simulator &inputSim);
+	void makeMove();
+};
+
+#ifndef HEADER_OLNY_INLINE
+#define HEADER_OLNY_INLINE
+#define HEADER_OLNY_STATIC
+#endif
+
+HEADER_OLNY_INLINE void makeMoveSimple(Side side, Simulator &sim)
+{
+	for (MyElevator & elevator : sim.elevators)
+	{
+		if (elevator.side == side)
+		{
+			for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+			{
+				MyPassenger &passenger = passengerEntry.second;
+				int elAbsX = std::abs(elevator.x) ;
+				if (elAbsX < 70 || elAbsX < 150 && passenger.dest_floor < 5 || elAbsX >= 150 && passenger.dest_floor >= 5)
+				{
+					if ((int) passenger.state < 4)
+					{
+						if (elevator.state != EState::MOVING)
+						{
+							elevator.go_to_floor = passenger.from_floor;
+						}
+						if (elevator.getFloor() == passenger.from_floor)
+						{
+							passenger.set_elevator.insert(elevator.id);
+						}
+					}
+				}
+			}
+			
+			if (elevator.passengers.size() > 0 && elevator.state != EState::MOVING) {
+				int delta = 100;
+				int targetFloor = 0;
+				for (int id : elevator.passengers)
+				{
+					MyPassenger &pass = sim.passengers[id];
+					int d = std::abs(elevator.getFloor() - pass.dest_floor);
+					if (d < delta)
+					{
+						delta = d;
+						targetFloor = pass.dest_floor;
+					}
+				}
+				elevator.go_to_floor = targetFloor;
+            }
+            
+            if (elevator.getFloor() == 0 && sim.tick < 2000 && elevator.passengers.size() < 20 || elevator.time_on_the_floor_with_opened_doors < 200 && elevator.passengers.size() < 4)
+				elevator.go_to_floor = -1;
+		}
+	}
+}
+
+
+HEADER_OLNY_INLINE int getNearestToLevelDestination(Simulator &sim, MyElevator& elevator, int level)
+{
+    int delta = 1000;
+    int targetFloor = level;
+    for (int id : elevator.passengers)
+    {
+        MyPassenger &pass = sim.passengers[id];
+        int d = std::abs(level - pass.dest_floor);
+        if (d < delta)
+        {
+            delta = d;
+            targetFloor = pass.dest_floor;
+        }
+    }
+    
+    if (targetFloor == level)
+	{
+		return rand() % 8 + 1;
+	}
+
+    return targetFloor;
+}
+
+HEADER_OLNY_INLINE int getNearestToLevelDestinationNoRand(Simulator &sim, MyElevator& elevator, int level)
+{
+    int targetFloor = level;
+
+	std::map<int, int> points;
+	
+    for (int id : elevator.passengers)
+    {
+        MyPassenger &pass = sim.passengers[id];
+		int d = -std::abs(pass.dest_floor - pass.from_floor);
+		points[pass.dest_floor] += d;
+    }
+
+    auto x = std::min_element(points.begin(), points.end(),
+    [level](const std::pair<int, int>& p1, const std::pair<int, int>& p2) {
+        return (p1.second + 7*std::abs(level - p1.first)) < (p2.second + 7*std::abs(level - p2.first)); });
+
+	if (x != points.end())
+		return x->first;
+	
+    return targetFloor;
+}
+
+HEADER_OLNY_INLINE MyStrategy::MyStrategy(Side side) : side(side)
+{
+	strategy1.side = side;
+	strategy2.side = side;
+	strategy3.side = side;
+	strategy4.side = side;
+	
+	strategy1.firstMoveMinDest = 6;
+	strategy2.firstMoveMinDest = 5;
+	strategy3.firstMoveMinDest = 3;
+	strategy4.firstMoveMinDest = 2;
+}
+
+HEADER_OLNY_INLINE MyStrategy::~MyStrategy()
+{
+
+}
+
+HEADER_OLNY_INLINE void MyStrategy::makeMove()
+{
+	for (MyElevator & elevator : sim.elevators)
+    {
+        if (elevator.side == side && elevator.ind == 0)
+        {
+			strategy1.makeMove(sim, elevator, this);
+        }
+        else if (elevator.side == side && elevator.ind == 1)
+        {
+			strategy2.makeMove(sim, elevator, this);
+        }
+        else if (elevator.side == side && elevator.ind == 2)
+        {
+			strategy3.makeMove(sim, elevator, this);
+        }
+        else if (elevator.side == side && elevator.ind == 3)
+        {
+			strategy4.makeMove(sim, elevator, this);
+		}
+    }
+}
+
+HEADER_OLNY_INLINE void MyStrategy::makeMove(Simulator &inputSim)
+{
+    sim.synchronizeWith(inputSim);
+    makeMove();
+    inputSim.copyCommandsFrom(sim, side);
+    sim.step();
+}
+
+HEADER_OLNY_INLINE void ElevatorStrategyUpDown::recalcDestinationBeforeDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+{
+	int res = -100000;
+	int targetFloor = -1;
+	
+	Side enemySide = inverseSide(strategy->side);
+	for (int i = 0; i < LEVELS_COUNT; ++i)
+	{
+		if (i != elevator.getFloor())
+		{
+			MyStrategy copy = *strategy;
+			copy.strategy1.doPredictions = false;
+			copy.strategy2.doPredictions = false;
+			copy.strategy3.doPredictions = false;
+			copy.strategy4.doPredictions = false;
+			
+			MyElevator &el = copy.sim.elevators[elevator.id];
+			el.go_to_floor = i;
+			
+			for (int tick = 0; tick < 400; ++tick)
+			{
+				//makeMoveSimple(enemySide, copy.sim);
+				copy.makeMove();
+				copy.sim.step();
+			}
+			
+			int valLeft = copy.sim.scores[0] + copy.sim.totalCargoValue(Side::LEFT).points / 2;
+			int valRight = copy.sim.scores[1] + copy.sim.totalCargoValue(Side::RIGHT).points / 2;
+			// 1000 ticks
+			// /3 RES: 1.09252 8088.1 8836.4 W 78 L 22 GOOD!
+			// /1.5 RES: 1.09848 8163.4 8967.3 W 80 L 20 GOOD!
+			// /2 RES: 1.10654 8272 9153.3 W 84 L 16 GOOD!!
+			// 500 ticks
+			// 300 RES: 1.13074 8058.8 9112.4 W 85 L 15 GOOD!!
+			// 400 RES: 1.21191 7952.8 9638.1 W 93 L 7 GOOD!!!!
+			// 500 RES: 1.17981 8093.7 9549 W 92 L 8 GOOD!!
+			// 600 RES: 1.16856 7998.3 9346.5 W 90 L 10 GOOD!!
+			// 700 RES: 1.17386 7896.1 9268.9 W 89 L 11 GOOD!!
+			// 400/2 RES: 1.21191 7952.8 9638.1 W 93 L 7 GOOD!!!!
+			// 400/1.7 RES: 1.19318 7929.3 9461.1 W 89 L 11 GOOD!!
+			// 400/2.2 RES: 1.1988 7974 9559.2 W 91 L 9 GOOD!!
+			
+			int points;
+			if (copy.side == Side::LEFT)
+				points = valLeft - valRight;
+			else
+				points = valRight - valLeft;
+			
+			//std::cout << "PTS " << i << " " << valLeft << " " << valRight << " " << points << std::endl;
+			if (i == elevator.next_floor)
+				++points;
+			if (points > res)
+			{
+				res = points;
+				targetFloor = i;
+			}
+		}
+	}
+	
+	if (targetFloor != -1)
+	{
+		int prevTarget = elevator.next_floor;
+		elevator.go_to_floor = targetFloor;
+		//std::cout << " Target " << targetFloor << " OLD " << prevTarget << std::endl;
+	}
+}
+
+}
+
+namespace strat3340 {
+	enum class Direction {
+    UP, DOWN
+};
+
+int getNearestToLevelDestination(Simulator &sim, MyElevator& elevator, int level);
+int getNearestToLevelDestinationNoRand(Simulator &sim, MyElevator& elevator, int level);
+
+class MyStrategy;
+struct ElevatorStrategyUpDown
+{
+	Side side;
+	Direction dir = Direction::UP;
+	int dirChanges = 0;
+	int firstMoveMinDest = 0;
+	bool doPredictions = true;
+	
+	void makeMove(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+	{
+		Direction old = dir;
+		doMakeMove(sim, elevator, strategy);
+		if (old != dir)
+			++dirChanges;
+	}
+	
+	void doMakeMove(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+	{
+		if (dir == Direction::UP && elevator.getFloor() == (LEVELS_COUNT - 1))
+			dir = Direction::DOWN;
+		else if (dir == Direction::DOWN && elevator.getFloor() == 0)
+			dir = Direction::UP;
+		
+		if (doPredictions && elevator.state == EState::CLOSING && elevator.closing_or_opening_ticks == 98)
+		{
+			recalcDestinationBeforeDoorsClose(sim, elevator, strategy);
+			return;
+		}
+		
+		if (elevator.state != EState::FILLING)
+			return;
+		
+		Value value = sim.getCargoValue(elevator);
+		
+		int floor = elevator.getFloor();
+		
+		if (elevator.passengers.size() == MAX_PASSENGERS)
+		{
+			int go_to_floor = strat3340::getNearestToLevelDestinationNoRand(sim, elevator, elevator.getFloor());
+			goToFloor(elevator, go_to_floor);
+		}
+		
+		int passCount = invitePassengers(sim, elevator);
+		if (sim.tick < 1980 && floor == 0)
+			++passCount;
+        
+		bool anyElevatorsCloserThanMe = false;
+		for (MyElevator &otherEl : sim.elevators)
+		{
+			if (otherEl.side == side && otherEl.state == EState::FILLING && otherEl.getFloor() == floor && otherEl.ind < elevator.ind)
+			{
+				anyElevatorsCloserThanMe = true;
+				break;
+			}
+		}
+		
+        if (!passCount)
+		{
+			//int maxWait = 300 - std::max(0, (int) (elevator.passengers.size()) - 12) * 25;
+			int maxWait = 550 - std::max(0, (int) (elevator.passengers.size()) - 12) * 50;
+			int ticksToWait = std::min(std::max(0, 7200 - sim.tick - value.ticks), maxWait);
+			//std::cout << "Wait " << ticksToWait << std::endl;
+			for (auto && p = sim.outPassengers.begin(); p != sim.outPassengers.upper_bound(sim.tick + ticksToWait); ++p)
+			{
+				if (p->second.getFloor() == floor)
+					++passCount;
+			}
+		}
+		
+		if (!passCount)
+		{
+			int go_to_floor = strat3340::getNearestToLevelDestinationNoRand(sim, elevator, elevator.getFloor());
+			if (go_to_floor != floor)
+			{
+				goToFloor(elevator, go_to_floor);
+			}
+			else
+			{
+				// TODO
+				if (dir == Direction::UP)
+					goToFloor(elevator, floor + 1);
+				else
+					goToFloor(elevator, floor - 1);
+			}
+		}
+	}
+	
+	void recalcDestinationBeforeDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy);
+	
+	void goToFloor(MyElevator &elevator, int go_to_floor)
+	{
+        if (go_to_floor > elevator.getFloor())
+            dir = Direction::UP;
+        else
+            dir = Direction::DOWN;
+        elevator.go_to_floor = go_to_floor;
+	}
+	
+	int invitePassengers(Simulator &sim, MyElevator &elevator)
+	{
+		int passCount = 0;
+		int floor = elevator.getFloor();
+		
+		bool anyElevatorsCloser = false;
+		/*for (MyElevator &e : sim.elevators)
+		{
+			if (e.id != elevator.id && e.ind <= elevator.ind && e.state == EState::FILLING && e.getFloor() == floor && e.side != elevator.side)
+			{
+				anyElevatorsCloser = true;
+				break;
+			}
+		}*/
+		
+		//std::bitset<LEVELS_COUNT> levels;
+		
+		std::multimap<int, MyPassenger *> passengers;
+		
+		for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+        {
+            MyPassenger &passenger = passengerEntry.second;
+            int dest_floor = passenger.dest_floor;
+			
+            //if (dir == Direction::UP && passenger.dest_floor > passenger.from_floor || dir == Direction::DOWN && passenger.dest_floor < passenger.from_floor)
+            {
+				if (floor == 0 && dirChanges == 0 && dest_floor <= firstMoveMinDest && sim.tick < 1980)
+					continue;
+				
+                if (passenger.getFloor() == floor)
+				{
+					if (passenger.state == PState::WAITING_FOR_ELEVATOR || passenger.state == PState::RETURNING)
+					{
+						if (anyElevatorsCloser)
+						{
+							passenger.set_elevator.insert(elevator.id);
+							++passCount;
+						}
+						else
+						{
+							passengers.insert(std::make_pair(passenger.getValue(side), &passenger));
+						}
+					}
+					else if (passenger.state == PState::MOVING_TO_ELEVATOR && passenger.elevator == elevator.id)
+					{
+						++passCount;
+						//levels.set(dest_floor);
+					}
+				}
+            }
+        }
+		
+		if (!anyElevatorsCloser)
+		{
+			int limit = MAX_PASSENGERS - (int) elevator.passengers.size() - passCount;
+			//std::cout << "LIMIT " << limit << " " << passengers.size() << std::endl;
+			
+			for (auto it = passengers.rbegin(); it != passengers.rend(); ++it)
+			{
+				if (limit <= 0)
+					break;
+				
+				if (limit <= 2 && it->first < 30 || limit <= 4 && it->first < 20)
+					continue;
+				
+				it->second->set_elevator.insert(elevator.id);
+				++passCount;
+				
+				--limit;
+			}
+		}
+		
+        return passCount;
+	}
+};
+
+class MyStrategy
+{
+public:
+	Side side;
+	Simulator sim;
+	ElevatorStrategyUpDown strategy1;
+	ElevatorStrategyUpDown strategy2;
+	ElevatorStrategyUpDown strategy3;
+	ElevatorStrategyUpDown strategy4;
+
+    MyStrategy(Side side);
+    ~MyStrategy();
+	
+	void makeMove(Simulator &inputSim);
+	void makeMove();
+};
+
+HEADER_OLNY_INLINE int getNearestToLevelDestination(Simulator &sim, MyElevator& elevator, int level)
+{
+    int delta = 1000;
+    int targetFloor = level;
+    for (int id : elevator.passengers)
+    {
+        MyPassenger &pass = sim.passengers[id];
+        int d = std::abs(level - pass.dest_floor);
+        if (d < delta)
+        {
+            delta = d;
+            targetFloor = pass.dest_floor;
+        }
+    }
+    
+    if (targetFloor == level)
+	{
+		return sim.random.get_random() % 8 + 1;
+	}
+
+    return targetFloor;
+}
+
+HEADER_OLNY_INLINE int getNearestToLevelDestinationNoRand(Simulator &sim, MyElevator& elevator, int level)
+{
+    int targetFloor = level;
+
+	std::map<int, int> points;
+	
+    for (int id : elevator.passengers)
+    {
+        MyPassenger &pass = sim.passengers[id];
+		int d = -std::abs(pass.dest_floor - pass.from_floor);
+		points[pass.dest_floor] += d;
+    }
+
+    auto x = std::min_element(points.begin(), points.end(),
+    [level](const std::pair<int, int>& p1, const std::pair<int, int>& p2) {
+        return (p1.second + 7*std::abs(level - p1.first)) < (p2.second + 7*std::abs(level - p2.first)); });
+
+	if (x != points.end())
+		return x->first;
+	
+    return targetFloor;
+}
+
+HEADER_OLNY_INLINE MyStrategy::MyStrategy(Side side) : side(side)
+{
+	strategy1.side = side;
+	strategy2.side = side;
+	strategy3.side = side;
+	strategy4.side = side;
+	
+	strategy1.firstMoveMinDest = 6;
+	strategy2.firstMoveMinDest = 5;
+	strategy3.firstMoveMinDest = 3;
+	strategy4.firstMoveMinDest = 2;
+}
+
+HEADER_OLNY_INLINE MyStrategy::~MyStrategy()
+{
+
+}
+
+HEADER_OLNY_INLINE void MyStrategy::makeMove()
+{
+	for (MyElevator & elevator : sim.elevators)
+    {
+        if (elevator.side == side && elevator.ind == 0)
+        {
+			strategy1.makeMove(sim, elevator, this);
+        }
+        else if (elevator.side == side && elevator.ind == 1)
+        {
+			strategy2.makeMove(sim, elevator, this);
+        }
+        else if (elevator.side == side && elevator.ind == 2)
+        {
+			strategy3.makeMove(sim, elevator, this);
+        }
+        else if (elevator.side == side && elevator.ind == 3)
+        {
+			strategy4.makeMove(sim, elevator, this);
+		}
+    }
+}
+
+HEADER_OLNY_INLINE void MyStrategy::makeMove(Simulator &inputSim)
+{
+    sim.synchronizeWith(inputSim);
+    makeMove();
+    inputSim.copyCommandsFrom(sim, side);
+    sim.step();
+}
+
+HEADER_OLNY_INLINE void ElevatorStrategyUpDown::recalcDestinationBeforeDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+{
+	int res = -100000;
+	int targetFloor = -1;
+	
+	Side enemySide = inverseSide(strategy->side);
+	for (int i = 0; i < LEVELS_COUNT; ++i)
+	{
+		if (i != elevator.getFloor())
+		{
+			MyStrategy copy = *strategy;
+			copy.strategy1.doPredictions = false;
+			copy.strategy2.doPredictions = false;
+			copy.strategy3.doPredictions = false;
+			copy.strategy4.doPredictions = false;
+			
+			MyElevator &el = copy.sim.elevators[elevator.id];
+			el.go_to_floor = i;
+			
+			for (int tick = 0; tick < 400; ++tick)
+			{
+				//makeMoveSimple(enemySide, copy.sim);
+				copy.makeMove();
+				copy.sim.step();
+			}
+			
+			int valLeft = copy.sim.scores[0] + copy.sim.passengersTotal[0]*10 + copy.sim.totalCargoValue(Side::LEFT).points / 2;
+			int valRight = copy.sim.scores[1] + copy.sim.passengersTotal[1]*10 + copy.sim.totalCargoValue(Side::RIGHT).points / 2;
+			// 1000 ticks
+			// /3 RES: 1.09252 8088.1 8836.4 W 78 L 22 GOOD!
+			// /1.5 RES: 1.09848 8163.4 8967.3 W 80 L 20 GOOD!
+			// /2 RES: 1.10654 8272 9153.3 W 84 L 16 GOOD!!
+			// 500 ticks
+			// 300 RES: 1.13074 8058.8 9112.4 W 85 L 15 GOOD!!
+			// 400 RES: 1.21191 7952.8 9638.1 W 93 L 7 GOOD!!!!
+			// 500 RES: 1.17981 8093.7 9549 W 92 L 8 GOOD!!
+			// 600 RES: 1.16856 7998.3 9346.5 W 90 L 10 GOOD!!
+			// 700 RES: 1.17386 7896.1 9268.9 W 89 L 11 GOOD!!
+			// 400/2 RES: 1.21191 7952.8 9638.1 W 93 L 7 GOOD!!!!
+			// 400/1.7 RES: 1.19318 7929.3 9461.1 W 89 L 11 GOOD!!
+			// 400/2.2 RES: 1.1988 7974 9559.2 W 91 L 9 GOOD!!
+			// *5 RES: 0.997525 9089.7 9067.2 W 41 L 59
+			// *10 RES: 1.01355 9031.3 9153.7 W 52 L 47.6667
+			// *20 RES: 1.0114 9086.8 9190.4 W 54 L 46
+			// *30 RES: 0.990421 9259.5 9170.8 W 41 L 58
+			// *40 RES: 1.00459 9193.9 9236.1 W 52 L 48
+			// *50 RES: 0.993825 9311.4 9253.9 W 52 L 48
+			// *60 RES: 0.994047 9306 9250.6 W 44 L 56
+			// *70 RES: 0.998478 9328.5 9314.3 W 48 L 51
+			// *100 RES: 0.965599 9525.8 9198.1 W 38 L 62
+			
+			
+			int points;
+			if (copy.side == Side::LEFT)
+				points = valLeft - valRight;
+			else
+				points = valRight - valLeft;
+			
+			//std::cout << "PTS " << i << " " << valLeft << " " << valRight << " " << points << std::endl;
+			if (i == elevator.next_floor)
+				++points;
+			if (points > res)
+			{
+				res = points;
+				targetFloor = i;
+			}
+		}
+	}
+	
+	if (targetFloor != -1)
+	{
+		int prevTarget = elevator.next_floor;
+		elevator.go_to_floor = targetFloor;
+		//std::cout << " Target " << targetFloor << " OLD " << prevTarget << std::endl;
+	}
+}
+}
+
+namespace strat3659 {
+	enum class Direction {
+    UP, DOWN
+};
+
+int getNearestToLevelDestination(Simulator &sim, MyElevator& elevator, int level);
+int getNearestToLevelDestinationNoRand(Simulator &sim, MyElevator& elevator, int level);
+
+class MyStrategy;
+struct ElevatorStrategyUpDown
+{
+	Side side;
+	Direction dir = Direction::UP;
+	int dirChanges = 0;
+	int firstMoveMinDest = 0;
+	bool doPredictions = true;
+	
+	void makeMove(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+	{
+		Direction old = dir;
+		doMakeMove(sim, elevator, strategy);
+		if (old != dir)
+			++dirChanges;
+	}
+	
+	void doMakeMove(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+	{
+		if (dir == Direction::UP && elevator.getFloor() == (LEVELS_COUNT - 1))
+			dir = Direction::DOWN;
+		else if (dir == Direction::DOWN && elevator.getFloor() == 0)
+			dir = Direction::UP;
+		
+		if (doPredictions && elevator.state == EState::CLOSING && elevator.closing_or_opening_ticks == 98)
+		{
+			recalcDestinationBeforeDoorsClose(sim, elevator, strategy);
+			return;
+		}
+		
+		if (elevator.state != EState::FILLING)
+			return;
+		
+		Value value = sim.getCargoValueBug(elevator);
+		
+		int floor = elevator.getFloor();
+		
+		if (elevator.passengers.size() == MAX_PASSENGERS)
+		{
+			int go_to_floor = strat3659::getNearestToLevelDestinationNoRand(sim, elevator, elevator.getFloor());
+			goToFloor(elevator, go_to_floor);
+		}
+		
+		int passCount = invitePassengers(sim, elevator);
+		if (sim.tick < 1980 && floor == 0)
+			++passCount;
+        
+		bool anyElevatorsCloserThanMe = false;
+		for (MyElevator &otherEl : sim.elevators)
+		{
+			if (otherEl.side == side && otherEl.state == EState::FILLING && otherEl.getFloor() == floor && otherEl.ind < elevator.ind)
+			{
+				anyElevatorsCloserThanMe = true;
+				break;
+			}
+		}
+		
+        if (!passCount)
+		{
+			//int maxWait = 300 - std::max(0, (int) (elevator.passengers.size()) - 12) * 25;
+			int maxWait = 550 - std::max(0, (int) (elevator.passengers.size()) - 12) * 50;
+			int ticksToWait = std::min(std::max(0, 7200 - sim.tick - value.ticks), maxWait);
+			//std::cout << "Wait " << ticksToWait << std::endl;
+			for (auto && p = sim.outPassengers.begin(); p != sim.outPassengers.upper_bound(sim.tick + ticksToWait); ++p)
+			{
+				if (p->second.getFloor() == floor)
+					++passCount;
+			}
+		}
+		
+		// 6700 RES: 1.044 9469.8 9886.5 W 70 L 30 GOOD
+		// 6800 RES: 1.06317 9324.9 9914 W 75 L 24 GOOD!
+		// 6900 RES: 1.06301 9324.9 9912.5 W 75 L 24 GOOD!
+		// 8 RES: 1.04497 9470.8 9896.7 W 72 L 28 GOOD
+		if (!passCount)
+		{
+			int go_to_floor = strat3659::getNearestToLevelDestinationNoRand(sim, elevator, elevator.getFloor());
+			if (go_to_floor != floor)
+			{
+				goToFloor(elevator, go_to_floor);
+			}
+			else
+			{
+				// TODO
+				if (dir == Direction::UP)
+					goToFloor(elevator, floor + 1);
+				else
+					goToFloor(elevator, floor - 1);
+			}
+		}
+	}
+	
+	void recalcDestinationBeforeDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy);
+	
+	void goToFloor(MyElevator &elevator, int go_to_floor)
+	{
+        if (go_to_floor > elevator.getFloor())
+            dir = Direction::UP;
+        else
+            dir = Direction::DOWN;
+        elevator.go_to_floor = go_to_floor;
+	}
+	
+	int invitePassengers(Simulator &sim, MyElevator &elevator)
+	{
+		int passCount = 0;
+		int floor = elevator.getFloor();
+		
+		bool anyElevatorsCloser = false;
+		/*for (MyElevator &e : sim.elevators)
+		{
+			if (e.id != elevator.id && e.ind <= elevator.ind && e.state == EState::FILLING && e.getFloor() == floor && e.side != elevator.side)
+			{
+				anyElevatorsCloser = true;
+				break;
+			}
+		}*/
+		
+		//std::bitset<LEVELS_COUNT> levels;
+		
+		std::multimap<int, MyPassenger *> passengers;
+		
+		for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+        {
+            MyPassenger &passenger = passengerEntry.second;
+            int dest_floor = passenger.dest_floor;
+			
+			if (std::abs(dest_floor - passenger.from_floor) <= 1)
+				continue;
+			
+            //if (dir == Direction::UP && passenger.dest_floor > passenger.from_floor || dir == Direction::DOWN && passenger.dest_floor < passenger.from_floor)
+            {
+				if (floor == 0 && dirChanges == 0 && dest_floor <= firstMoveMinDest && sim.tick < 1980)
+					continue;
+				
+                if (passenger.getFloor() == floor)
+				{
+					if (passenger.state == PState::WAITING_FOR_ELEVATOR || passenger.state == PState::RETURNING)
+					{
+						if (anyElevatorsCloser)
+						{
+							passenger.set_elevator.insert(elevator.id);
+							++passCount;
+						}
+						else
+						{
+							passengers.insert(std::make_pair(passenger.getValue(side), &passenger));
+						}
+					}
+					else if (passenger.state == PState::MOVING_TO_ELEVATOR && passenger.elevator == elevator.id)
+					{
+						++passCount;
+						//levels.set(dest_floor);
+					}
+				}
+            }
+        }
+		
+		if (!anyElevatorsCloser)
+		{
+			int limit = MAX_PASSENGERS - (int) elevator.passengers.size() - passCount;
+			//std::cout << "LIMIT " << limit << " " << passengers.size() << std::endl;
+			
+			for (auto it = passengers.rbegin(); it != passengers.rend(); ++it)
+			{
+				if (limit <= 0)
+					break;
+				
+				if (limit <= 2 && it->first < 30 || limit <= 4 && it->first < 20)
+					continue;
+				
+				it->second->set_elevator.insert(elevator.id);
+				++passCount;
+				
+				--limit;
+			}
+		}
+		
+        return passCount;
+	}
+};
+
+class MyStrategy
+{
+public:
+	Side side;
+	Simulator sim;
+	ElevatorStrategyUpDown strategy1;
+	ElevatorStrategyUpDown strategy2;
+	ElevatorStrategyUpDown strategy3;
+	ElevatorStrategyUpDown strategy4;
+
+    MyStrategy(Side side);
+    ~MyStrategy();
+	
+	void makeMove(Simulator &inputSim);
+	void makeMove();
+};
+
+#ifndef HEADER_OLNY_INLINE
+#define HEADER_OLNY_INLINE
+#define HEADER_OLNY_STATIC
+#endif
+
+HEADER_OLNY_INLINE int getNearestToLevelDestination(Simulator &sim, MyElevator& elevator, int level)
+{
+    int delta = 1000;
+    int targetFloor = level;
+    for (int id : elevator.passengers)
+    {
+        MyPassenger &pass = sim.passengers[id];
+        int d = std::abs(level - pass.dest_floor);
+        if (d < delta)
+        {
+            delta = d;
+            targetFloor = pass.dest_floor;
+        }
+    }
+    
+    if (targetFloor == level)
+	{
+		return sim.random.get_random() % 8 + 1;
+	}
+
+    return targetFloor;
+}
+
+HEADER_OLNY_INLINE int getNearestToLevelDestinationNoRand(Simulator &sim, MyElevator& elevator, int level)
+{
+    int targetFloor = level;
+
+	std::map<int, int> points;
+	
+    for (int id : elevator.passengers)
+    {
+        MyPassenger &pass = sim.passengers[id];
+		points[pass.dest_floor] -= pass.getValue(elevator.side);
+    }
+    
+    /*for (std::pair<const int, MyPassenger> &p : sim.outPassengers)
+	{
+		int floor = p.second.getFloor();
+		if (floor != level)
+		{
+			int pts = -10;
+			if (p.second.side != elevator.side)
+				pts *= 2;
+			if (points.count(floor))
+				points[floor] += pts;
+		}
+	}*/
+	// 0 RES: 1.06403 9456 10061.5 rem 1683.2 997.2 W 76 L 24 GOOD!
+	// 30 RES: 1.03688 9647.1 10002.9 rem 1680 1098.9 W 59 L 40 GOOD
+	// 10 RES: 1.04705 9618.8 10071.4 rem 1738.1 973.5 W 62 L 37 GOOD
+	// 1 RES: 1.04413 9608.1 10032.1 rem 1668.4 974.9 W 69 L 30 GOOD
+
+    auto x = std::min_element(points.begin(), points.end(),
+    [level](const std::pair<int, int>& p1, const std::pair<int, int>& p2) {
+        return (p1.second + 70*std::abs(level - p1.first)) < (p2.second + 70*std::abs(level - p2.first)); });
+
+	if (x != points.end())
+		return x->first;
+	
+    return targetFloor;
+}
+
+HEADER_OLNY_INLINE MyStrategy::MyStrategy(Side side) : side(side)
+{
+	strategy1.side = side;
+	strategy2.side = side;
+	strategy3.side = side;
+	strategy4.side = side;
+	
+	strategy1.firstMoveMinDest = 6;
+	strategy2.firstMoveMinDest = 5;
+	strategy3.firstMoveMinDest = 3;
+	strategy4.firstMoveMinDest = 2;
+}
+
+HEADER_OLNY_INLINE MyStrategy::~MyStrategy()
+{
+
+}
+
+HEADER_OLNY_INLINE void MyStrategy::makeMove()
+{
+	for (MyElevator & elevator : sim.elevators)
+    {
+        if (elevator.side == side && elevator.ind == 0)
+        {
+			strategy1.makeMove(sim, elevator, this);
+        }
+        else if (elevator.side == side && elevator.ind == 1)
+        {
+			strategy2.makeMove(sim, elevator, this);
+        }
+        else if (elevator.side == side && elevator.ind == 2)
+        {
+			strategy3.makeMove(sim, elevator, this);
+        }
+        else if (elevator.side == side && elevator.ind == 3)
+        {
+			strategy4.makeMove(sim, elevator, this);
+		}
+    }
+}
+
+HEADER_OLNY_INLINE void MyStrategy::makeMove(Simulator &inputSim)
+{
+    sim.synchronizeWith(inputSim);
+    makeMove();
+    inputSim.copyCommandsFrom(sim, side);
+    sim.step();
+}
+
+HEADER_OLNY_INLINE void ElevatorStrategyUpDown::recalcDestinationBeforeDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+{
+	int res = -100000;
+	int targetFloor = -1;
+	
+	Side enemySide = inverseSide(strategy->side);
+	int maxTicks = 7200 - sim.tick;
+	float coef = 1.0;
+	if (maxTicks < 1500)
+		coef = ((float)maxTicks - 200.0f) / 1300.0f;
+	
+	for (int i = 0; i < LEVELS_COUNT; ++i)
+	{
+		if (i != elevator.getFloor())
+		{
+			MyStrategy copy = *strategy;
+			copy.strategy1.doPredictions = false;
+			copy.strategy2.doPredictions = false;
+			copy.strategy3.doPredictions = false;
+			copy.strategy4.doPredictions = false;
+			
+			MyElevator &el = copy.sim.elevators[elevator.id];
+			el.go_to_floor = i;
+			
+			for (int tick = 0; tick < 500; ++tick)
+			{
+				//makeMoveSimple(enemySide, copy.sim);
+				copy.makeMove();
+				copy.sim.step();
+			}
+			
+			int valLeft = copy.sim.scores[0] + copy.sim.passengersTotal[0]*10 + copy.sim.totalCargoValue(Side::LEFT).points / 2 * coef;
+			int valRight = copy.sim.scores[1] + copy.sim.passengersTotal[1]*10 + copy.sim.totalCargoValue(Side::RIGHT).points / 2 * coef;
+			// 1000 ticks
+			// /3 RES: 1.09252 8088.1 8836.4 W 78 L 22 GOOD!
+			// /1.5 RES: 1.09848 8163.4 8967.3 W 80 L 20 GOOD!
+			// /2 RES: 1.10654 8272 9153.3 W 84 L 16 GOOD!!
+			// 500 ticks
+			// 300 RES: 1.13074 8058.8 9112.4 W 85 L 15 GOOD!!
+			// 400 RES: 1.21191 7952.8 9638.1 W 93 L 7 GOOD!!!!
+			// 500 RES: 1.17981 8093.7 9549 W 92 L 8 GOOD!!
+			// 600 RES: 1.16856 7998.3 9346.5 W 90 L 10 GOOD!!
+			// 700 RES: 1.17386 7896.1 9268.9 W 89 L 11 GOOD!!
+			// 400/2 RES: 1.21191 7952.8 9638.1 W 93 L 7 GOOD!!!!
+			// 400/1.7 RES: 1.19318 7929.3 9461.1 W 89 L 11 GOOD!!
+			// 400/2.2 RES: 1.1988 7974 9559.2 W 91 L 9 GOOD!!
+			// *5 RES: 0.997525 9089.7 9067.2 W 41 L 59
+			// *10 RES: 1.01355 9031.3 9153.7 W 52 L 47.6667
+			// *20 RES: 1.0114 9086.8 9190.4 W 54 L 46
+			// *30 RES: 0.990421 9259.5 9170.8 W 41 L 58
+			// *40 RES: 1.00459 9193.9 9236.1 W 52 L 48
+			// *50 RES: 0.993825 9311.4 9253.9 W 52 L 48
+			// *60 RES: 0.994047 9306 9250.6 W 44 L 56
+			// *70 RES: 0.998478 9328.5 9314.3 W 48 L 51
+			// *100 RES: 0.965599 9525.8 9198.1 W 38 L 62
+			
+			// 400 RES: 1.02644 8631.8 8860 W 60 L 40
+			// 450 RES: 1.01464 9333.3 9469.9 W 56 L 44
+			// 500 RES: 1.02015 9245.53 9431.87 W 58.3333 L 41.3333
+			// 600 RES: 1.00917 9399.1 9485.3 W 59 L 41
+			
+			
+			int points;
+			if (copy.side == Side::LEFT)
+				points = valLeft - valRight;
+			else
+				points = valRight - valLeft;
+			
+			//std::cout << "PTS " << i << " " << valLeft << " " << valRight << " " << points << std::endl;
+			if (i == elevator.next_floor)
+				++points;
+			if (points > res)
+			{
+				res = points;
+				targetFloor = i;
+			}
+		}
+	}
+	
+	if (targetFloor != -1)
+	{
+		int prevTarget = elevator.next_floor;
+		elevator.go_to_floor = targetFloor;
+		//std::cout << " Target " << targetFloor << " OLD " << prevTarget << std::endl;
+	}
+}
+}
+
+namespace strat3800 {
+	enum class Direction {
+    UP, DOWN
+};
+
+int getNearestToLevelDestination(Simulator &sim, MyElevator& elevator, int level);
+int getNearestToLevelDestinationNoRand(Simulator &sim, MyElevator& elevator, int level);
+
+class MyStrategy;
+struct ElevatorStrategyUpDown
+{
+	Side side;
+	Direction dir = Direction::UP;
+	int dirChanges = 0;
+	int firstMoveMinDest = 0;
+	bool doPredictions = true;
+	
+	void makeMove(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+	{
+		Direction old = dir;
+		doMakeMove(sim, elevator, strategy);
+		if (old != dir)
+			++dirChanges;
+	}
+	
+	void doMakeMove(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+	{
+		if (dir == Direction::UP && elevator.getFloor() == (LEVELS_COUNT - 1))
+			dir = Direction::DOWN;
+		else if (dir == Direction::DOWN && elevator.getFloor() == 0)
+			dir = Direction::UP;
+		
+		if (doPredictions && elevator.state == EState::CLOSING && elevator.closing_or_opening_ticks == 98)
+		{
+			recalcDestinationBeforeDoorsClose(sim, elevator, strategy);
+			return;
+		}
+		
+		if (elevator.state != EState::FILLING)
+			return;
+		
+		Value value = sim.getCargoValueBug(elevator);
+		
+		int floor = elevator.getFloor();
+		
+		if (elevator.passengers.size() == MAX_PASSENGERS)
+		{
+			int go_to_floor = strat3800::getNearestToLevelDestinationNoRand(sim, elevator, elevator.getFloor());
+			goToFloor(elevator, go_to_floor);
+		}
+		
+		int passCount = invitePassengers(sim, elevator);
+		if (sim.tick < 1980 && floor == 0)
+			++passCount;
+        
+		bool anyElevatorsCloserThanMe = false;
+		for (MyElevator &otherEl : sim.elevators)
+		{
+			if (otherEl.side == side && otherEl.state == EState::FILLING && otherEl.getFloor() == floor && otherEl.ind < elevator.ind)
+			{
+				anyElevatorsCloserThanMe = true;
+				break;
+			}
+		}
+		
+        if (!passCount)
+		{
+			//int maxWait = 300 - std::max(0, (int) (elevator.passengers.size()) - 12) * 25;
+			int maxWait = 550 - std::max(0, (int) (elevator.passengers.size()) - 12) * 50;
+			int ticksToWait = std::min(std::max(0, 7200 - sim.tick - value.ticks), maxWait);
+			//std::cout << "Wait " << ticksToWait << std::endl;
+			int t = -1;
+			for (auto && p = sim.outPassengers.begin(); p != sim.outPassengers.upper_bound(sim.tick + ticksToWait); ++p)
+			{
+				if (p->second.getFloor() == floor)
+				{
+					++passCount;
+					if (t == -1)
+						t = p->first;
+				}
+			}
+			
+			/*if (passCount && passCount <= 2 && (t - sim.tick) > 200) {
+				//std::cout << "IGNORE " << passCount << " " << (t - sim.tick) << std::endl;
+				passCount = 0;
+			}*/
+			
+			// 400 RES: 1.00352 9451.37 9484.6 rem 1081.03 1075.6 W 46 L 53
+			// RES: 1.00352 9451.37 9484.6 rem 1081.03 1075.6 W 46 L 53
+			// 200 RES: 1.01371 9412.37 9541.4 rem 1077.73 1073.87 W 54.3333 L 44.6667
+			
+			/*if (passCount && passCount <= 2 && doPredictions && elevator.time_on_the_floor_with_opened_doors > 40)
+			{
+				//std::cout << "11 " << std::endl;
+				//if (elevator.time_on_the_floor_with_opened_doors % 100 == 42)
+				{
+					if (recalcDoorsClose(sim, elevator, strategy)) {
+						std::cout << "CLOSE " << std::endl;
+						passCount = 0;
+					}
+					else
+					{
+						//std::cout << "DONT CLOSE " << std::endl;
+					}
+				}
+			}*/
+		}
+		
+		// RES: 0.994943 8661.2 8617.4 rem 953.7 944.5 W 39 L 35
+		// 100 RES: 1.0044 8900.5 8939.7 rem 987.4 981.3 W 44 L 37
+		// 200 RES: 1.01427 8606.9 8729.7 rem 967.7 899.7 W 41 L 25
+		// 300 RES: 1.00729 8577.4 8639.9 rem 927.7 896.5 W 36 L 27
+		// 400 RES: 1.00842 8525.4 8597.2 rem 936.3 866.2 W 34 L 29
+		
+		
+		
+		if (!passCount)
+		{
+			int go_to_floor = strat3800::getNearestToLevelDestinationNoRand(sim, elevator, elevator.getFloor());
+			if (go_to_floor != floor)
+			{
+				goToFloor(elevator, go_to_floor);
+			}
+			else
+			{
+				// TODO
+				if (dir == Direction::UP)
+					goToFloor(elevator, floor + 1);
+				else
+					goToFloor(elevator, floor - 1);
+			}
+		}
+	}
+	
+	void recalcDestinationBeforeDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy);
+	//bool recalcDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy);
+	
+	void goToFloor(MyElevator &elevator, int go_to_floor)
+	{
+        if (go_to_floor > elevator.getFloor())
+            dir = Direction::UP;
+        else
+            dir = Direction::DOWN;
+        elevator.go_to_floor = go_to_floor;
+	}
+	
+	int invitePassengers(Simulator &sim, MyElevator &elevator)
+	{
+		int passCount = 0;
+		int floor = elevator.getFloor();
+		
+		bool anyEnemyElevatorsCloser = false;
+		bool anyElevatorsCloser = false;
+		for (MyElevator &e : sim.elevators)
+		{
+			if (e.id != elevator.id && e.ind <= elevator.ind && e.state == EState::FILLING && e.getFloor() == floor && e.side != elevator.side)
+			{
+				anyEnemyElevatorsCloser = true;
+			}
+			if (e.id != elevator.id && e.ind <= elevator.ind && e.state == EState::FILLING && e.getFloor() == floor)
+			{
+				anyElevatorsCloser = true;
+			}
+		}
+		
+		//std::bitset<LEVELS_COUNT> levels;
+		
+		std::multimap<int, MyPassenger *> passengers;
+		
+		for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+        {
+            MyPassenger &passenger = passengerEntry.second;
+            int dest_floor = passenger.dest_floor;
+			
+			if (std::abs(dest_floor - passenger.from_floor) <= 1)
+				continue;
+			
+            //if (dir == Direction::UP && passenger.dest_floor > passenger.from_floor || dir == Direction::DOWN && passenger.dest_floor < passenger.from_floor)
+            {
+				if (floor == 0 && dirChanges == 0 && dest_floor <= firstMoveMinDest && sim.tick < 1980)
+					continue;
+				
+                if (passenger.getFloor() == floor)
+				{
+					if (passenger.state == PState::WAITING_FOR_ELEVATOR || passenger.state == PState::RETURNING)
+					{
+						/*if (anyElevatorsCloser)
+						{
+							passenger.set_elevator.insert(elevator.id);
+							++passCount;
+						}
+						else
+						{*/
+							passengers.insert(std::make_pair(passenger.getValue(side), &passenger));
+						//}
+					}
+					else if (passenger.state == PState::MOVING_TO_ELEVATOR && passenger.elevator == elevator.id)
+					{
+						++passCount;
+						//levels.set(dest_floor);
+					}
+				}
+            }
+        }
+		
+		//double maxDist = 0;
+		//if (!anyElevatorsCloser)
+		{
+			int limit = MAX_PASSENGERS - (int) elevator.passengers.size() - passCount;
+			if (anyEnemyElevatorsCloser || elevator.ind == 3 && anyElevatorsCloser)
+				limit += 3;
+			
+			for (auto it = passengers.rbegin(); it != passengers.rend(); ++it)
+			{
+				if (limit <= 0)
+					break;
+				
+				if (limit <= 2 && it->first < 30 || limit <= 4 && it->first < 20)
+					continue;
+				
+				it->second->set_elevator.insert(elevator.id);
+				++passCount;
+				
+				--limit;
+				
+				//maxDist = std::max(maxDist, std::abs(it->second->x - (double) elevator.x));
+			}
+			
+			/*for (auto it = passengers.rbegin(); it != passengers.rend(); ++it)
+			{
+				double dist = std::abs(it->second->x - (double) elevator.x);
+				if (dist > maxDist)
+					it->second->set_elevator.insert(elevator.id);
+			}*/
+		}
+		
+        return passCount;
+	}
+};
+
+class MyStrategy
+{
+public:
+	Side side;
+	Simulator sim;
+	ElevatorStrategyUpDown strategy1;
+	ElevatorStrategyUpDown strategy2;
+	ElevatorStrategyUpDown strategy3;
+	ElevatorStrategyUpDown strategy4;
+
+    MyStrategy(Side side);
+    ~MyStrategy();
+	
+	void makeMove(Simulator &inputSim);
+	void makeMove();
+};
+
+HEADER_OLNY_INLINE void makeMoveSimple(Side side, Simulator &sim)
+{
+	for (MyElevator & elevator : sim.elevators)
+	{
+		if (elevator.side == side)
+		{
+			for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+			{
+				MyPassenger &passenger = passengerEntry.second;
+				int elAbsX = std::abs(elevator.x) ;
+				if (elAbsX < 70 || elAbsX < 150 && passenger.dest_floor < 5 || elAbsX >= 150 && passenger.dest_floor >= 5)
+				{
+					if ((int) passenger.state < 4)
+					{
+						if (elevator.state != EState::MOVING)
+						{
+							elevator.go_to_floor = passenger.from_floor;
+						}
+						if (elevator.getFloor() == passenger.from_floor)
+						{
+							passenger.set_elevator.insert(elevator.id);
+						}
+					}
+				}
+			}
+			
+			if (elevator.passengers.size() > 0 && elevator.state != EState::MOVING) {
+				int delta = 100;
+				int targetFloor = 0;
+				for (int id : elevator.passengers)
+				{
+					MyPassenger &pass = sim.passengers[id];
+					int d = std::abs(elevator.getFloor() - pass.dest_floor);
+					if (d < delta)
+					{
+						delta = d;
+						targetFloor = pass.dest_floor;
+					}
+				}
+				elevator.go_to_floor = targetFloor;
+            }
+            
+            if (elevator.getFloor() == 0 && sim.tick < 2000 && elevator.passengers.size() < 20 || elevator.time_on_the_floor_with_opened_doors < 200 && elevator.passengers.size() < 4)
+				elevator.go_to_floor = -1;
+		}
+	}
+}
+
+
+HEADER_OLNY_INLINE int getNearestToLevelDestination(Simulator &sim, MyElevator& elevator, int level)
+{
+    int delta = 1000;
+    int targetFloor = level;
+    for (int id : elevator.passengers)
+    {
+        MyPassenger &pass = sim.passengers[id];
+        int d = std::abs(level - pass.dest_floor);
+        if (d < delta)
+        {
+            delta = d;
+            targetFloor = pass.dest_floor;
+        }
+    }
+    
+    if (targetFloor == level)
+	{
+		return sim.random.get_random() % 8 + 1;
+	}
+
+    return targetFloor;
+}
+
+HEADER_OLNY_INLINE int getNearestToLevelDestinationNoRand(Simulator &sim, MyElevator& elevator, int level)
+{
+    int targetFloor = level;
+
+	std::map<int, int> points;
+	
+    for (int id : elevator.passengers)
+    {
+        MyPassenger &pass = sim.passengers[id];
+		points[pass.dest_floor] -= pass.getValue(elevator.side);
+    }
+    
+    /*for (std::pair<const int, MyPassenger> &p : sim.outPassengers)
+	{
+		int floor = p.second.getFloor();
+		if (floor != level)
+		{
+			int pts = -10;
+			if (p.second.side != elevator.side)
+				pts *= 2;
+			if (points.count(floor))
+				points[floor] += pts;
+		}
+	}*/
+	// 0 RES: 1.06403 9456 10061.5 rem 1683.2 997.2 W 76 L 24 GOOD!
+	// 30 RES: 1.03688 9647.1 10002.9 rem 1680 1098.9 W 59 L 40 GOOD
+	// 10 RES: 1.04705 9618.8 10071.4 rem 1738.1 973.5 W 62 L 37 GOOD
+	// 1 RES: 1.04413 9608.1 10032.1 rem 1668.4 974.9 W 69 L 30 GOOD
+
+    auto x = std::min_element(points.begin(), points.end(),
+    [level](const std::pair<int, int>& p1, const std::pair<int, int>& p2) {
+        return (p1.second + 70*std::abs(level - p1.first)) < (p2.second + 70*std::abs(level - p2.first)); });
+
+	if (x != points.end())
+		return x->first;
+	
+    return targetFloor;
+}
+
+HEADER_OLNY_INLINE MyStrategy::MyStrategy(Side side) : side(side)
+{
+	strategy1.side = side;
+	strategy2.side = side;
+	strategy3.side = side;
+	strategy4.side = side;
+	
+	strategy1.firstMoveMinDest = 6;
+	strategy2.firstMoveMinDest = 5;
+	strategy3.firstMoveMinDest = 3;
+	strategy4.firstMoveMinDest = 2;
+}
+
+HEADER_OLNY_INLINE MyStrategy::~MyStrategy()
+{
+
+}
+
+HEADER_OLNY_INLINE void MyStrategy::makeMove()
+{
+	for (MyElevator & elevator : sim.elevators)
+    {
+        if (elevator.side == side && elevator.ind == 0)
+        {
+			strategy1.makeMove(sim, elevator, this);
+        }
+        else if (elevator.side == side && elevator.ind == 1)
+        {
+			strategy2.makeMove(sim, elevator, this);
+        }
+        else if (elevator.side == side && elevator.ind == 2)
+        {
+			strategy3.makeMove(sim, elevator, this);
+        }
+        else if (elevator.side == side && elevator.ind == 3)
+        {
+			strategy4.makeMove(sim, elevator, this);
+		}
+    }
+}
+
+HEADER_OLNY_INLINE void MyStrategy::makeMove(Simulator &inputSim)
+{
+    sim.synchronizeWith(inputSim);
+    makeMove();
+    inputSim.copyCommandsFrom(sim, side);
+    sim.step();
+}
+
+HEADER_OLNY_INLINE void ElevatorStrategyUpDown::recalcDestinationBeforeDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+{
+	int res = -100000;
+	int targetFloor = -1;
+	
+	Side enemySide = inverseSide(strategy->side);
+	int maxTicks = 7200 - sim.tick;
+	float coef = 1.0;
+	if (maxTicks < 1500)
+		coef = ((float)maxTicks - 200.0f) / 1300.0f;
+	
+	for (int i = 0; i < LEVELS_COUNT; ++i)
+	{
+		if (i != elevator.getFloor())
+		{
+			MyStrategy copy = *strategy;
+			copy.strategy1.doPredictions = false;
+			copy.strategy2.doPredictions = false;
+			copy.strategy3.doPredictions = false;
+			copy.strategy4.doPredictions = false;
+			
+			MyElevator &el = copy.sim.elevators[elevator.id];
+			el.go_to_floor = i;
+			
+			for (int tick = 0; tick < 500; ++tick)
+			{
+				//makeMoveSimple(enemySide, copy.sim);
+				copy.makeMove();
+				copy.sim.step();
+			}
+			
+			int valLeft = copy.sim.scores[0] + copy.sim.passengersTotal[0]*10 + copy.sim.totalCargoValue(Side::LEFT).points / 2 * coef;
+			int valRight = copy.sim.scores[1] + copy.sim.passengersTotal[1]*10 + copy.sim.totalCargoValue(Side::RIGHT).points / 2 * coef;
+			// 1000 ticks
+			// /3 RES: 1.09252 8088.1 8836.4 W 78 L 22 GOOD!
+			// /1.5 RES: 1.09848 8163.4 8967.3 W 80 L 20 GOOD!
+			// /2 RES: 1.10654 8272 9153.3 W 84 L 16 GOOD!!
+			// 500 ticks
+			// 300 RES: 1.13074 8058.8 9112.4 W 85 L 15 GOOD!!
+			// 400 RES: 1.21191 7952.8 9638.1 W 93 L 7 GOOD!!!!
+			// 500 RES: 1.17981 8093.7 9549 W 92 L 8 GOOD!!
+			// 600 RES: 1.16856 7998.3 9346.5 W 90 L 10 GOOD!!
+			// 700 RES: 1.17386 7896.1 9268.9 W 89 L 11 GOOD!!
+			// 400/2 RES: 1.21191 7952.8 9638.1 W 93 L 7 GOOD!!!!
+			// 400/1.7 RES: 1.19318 7929.3 9461.1 W 89 L 11 GOOD!!
+			// 400/2.2 RES: 1.1988 7974 9559.2 W 91 L 9 GOOD!!
+			// *5 RES: 0.997525 9089.7 9067.2 W 41 L 59
+			// *10 RES: 1.01355 9031.3 9153.7 W 52 L 47.6667
+			// *20 RES: 1.0114 9086.8 9190.4 W 54 L 46
+			// *30 RES: 0.990421 9259.5 9170.8 W 41 L 58
+			// *40 RES: 1.00459 9193.9 9236.1 W 52 L 48
+			// *50 RES: 0.993825 9311.4 9253.9 W 52 L 48
+			// *60 RES: 0.994047 9306 9250.6 W 44 L 56
+			// *70 RES: 0.998478 9328.5 9314.3 W 48 L 51
+			// *100 RES: 0.965599 9525.8 9198.1 W 38 L 62
+			
+			// 400 RES: 1.02644 8631.8 8860 W 60 L 40
+			// 450 RES: 1.01464 9333.3 9469.9 W 56 L 44
+			// 500 RES: 1.02015 9245.53 9431.87 W 58.3333 L 41.3333
+			// 600 RES: 1.00917 9399.1 9485.3 W 59 L 41
+			
+			
+			int points;
+			if (copy.side == Side::LEFT)
+				points = valLeft - valRight;
+			else
+				points = valRight - valLeft;
+			
+			//std::cout << "PTS " << i << " " << valLeft << " " << valRight << " " << points << std::endl;
+			if (i == elevator.next_floor)
+				++points;
+			if (points > res)
+			{
+				res = points;
+				targetFloor = i;
+			}
+		}
+	}
+	
+	if (targetFloor != -1)
+	{
+		int prevTarget = elevator.next_floor;
+		elevator.go_to_floor = targetFloor;
+		//std::cout << " Target " << targetFloor << " OLD " << prevTarget << std::endl;
+	}
+}
+}
+
+namespace strat3950 {
+	enum class Direction {
+    UP, DOWN
+};
+
+int getNearestToLevelDestination(Simulator &sim, MyElevator& elevator, int level);
+int getNearestToLevelDestinationNoRand(Simulator &sim, MyElevator& elevator, int level);
+
+class MyStrategy;
+struct ElevatorStrategyUpDown
+{
+	Side side;
+	Direction dir = Direction::UP;
+	int dirChanges = 0;
+	int firstMoveMinDest = 0;
+	bool doPredictions = true;
+	
+	void makeMove(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+	{
+		Direction old = dir;
+		doMakeMove(sim, elevator, strategy);
+		if (old != dir)
+			++dirChanges;
+	}
+	
+	void doMakeMove(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+	{
+		if (dir == Direction::UP && elevator.getFloor() == (LEVELS_COUNT - 1))
+			dir = Direction::DOWN;
+		else if (dir == Direction::DOWN && elevator.getFloor() == 0)
+			dir = Direction::UP;
+		
+		if (doPredictions && elevator.state == EState::CLOSING && elevator.closing_or_opening_ticks == 98)
+		{
+			recalcDestinationBeforeDoorsClose(sim, elevator, strategy);
+			return;
+		}
+		
+		if (elevator.state != EState::FILLING)
+			return;
+		
+		Value value = sim.getCargoValue(elevator);
+		
+		int floor = elevator.getFloor();
+		
+		if (elevator.passengers.size() == MAX_PASSENGERS)
+		{
+			int go_to_floor = strat3950::getNearestToLevelDestinationNoRand(sim, elevator, elevator.getFloor());
+			goToFloor(elevator, go_to_floor);
+		}
+		
+		int passCount = invitePassengers(sim, elevator);
+		if (sim.tick < 1980 && floor == 0)
+			++passCount;
+        
+		bool anyElevatorsCloserThanMe = false;
+		for (MyElevator &otherEl : sim.elevators)
+		{
+			if (otherEl.side == side && otherEl.state == EState::FILLING && otherEl.getFloor() == floor && otherEl.ind < elevator.ind)
+			{
+				anyElevatorsCloserThanMe = true;
+				break;
+			}
+		}
+		
+        if (!passCount)
+		{
+			bool anyElevatorsCloser = false;
+			/*for (MyElevator &e : sim.elevators)
+			{
+				if (e.id != elevator.id && e.ind < elevator.ind && e.state == EState::FILLING && e.getFloor() == floor && e.passengers.size() < 19)
+				{
+					anyElevatorsCloser = true;
+				}
+			}*/
+			
+			if (!anyElevatorsCloser)
+			{
+				//int maxWait = 300 - std::max(0, (int) (elevator.passengers.size()) - 12) * 25;
+				int maxWait = 550 - std::max(0, (int) (elevator.passengers.size()) - 12) * 50;
+				int ticksToWait = std::min(std::max(0, 7200 - sim.tick - value.ticks), maxWait);
+				//std::cout << "Wait " << ticksToWait << std::endl;
+				
+				// 450 RES: 0.995443 9296.17 9253.8 rem 1138.53 1094.03 W 50.3333 L 49
+				// 500 RES: 0.996442 9276.03 9243.03 rem 1120.8 1096.4 W 52.3333 L 47
+				// 550 RES: 0.994873 9211.97 9164.73 rem 1095.67 1100.7 W 52 L 47.3333
+				// RES: 1.00964 9188.13 9276.73 rem 1109.53 1112.33 W 56 L 43
+				
+				int t = -1;
+				for (auto && p = sim.outPassengers.begin(); p != sim.outPassengers.upper_bound(sim.tick + ticksToWait); ++p)
+				{
+					if (p->second.getFloor() == floor)
+					{
+						++passCount;
+						if (t == -1)
+							t = p->first;
+					}
+				}
+			}
+		}
+		
+		// RES: 0.994943 8661.2 8617.4 rem 953.7 944.5 W 39 L 35
+		// 100 RES: 1.0044 8900.5 8939.7 rem 987.4 981.3 W 44 L 37
+		// 200 RES: 1.01427 8606.9 8729.7 rem 967.7 899.7 W 41 L 25
+		// 300 RES: 1.00729 8577.4 8639.9 rem 927.7 896.5 W 36 L 27
+		// 400 RES: 1.00842 8525.4 8597.2 rem 936.3 866.2 W 34 L 29
+		
+		
+		int go_to_floor = strat3950::getNearestToLevelDestinationNoRand(sim, elevator, elevator.getFloor());
+		
+		if (!passCount/* && elevator.time_on_the_floor_with_opened_doors >= 40*/)
+		{
+			if (go_to_floor != floor)
+			{
+				goToFloor(elevator, go_to_floor);
+			}
+			else
+			{
+				int floorsPass[LEVELS_COUNT] = {};
+				for (auto && p = sim.outPassengers.begin(); p != sim.outPassengers.upper_bound(sim.tick + 800); ++p)
+				{
+					floorsPass[p->second.getFloor()] += p->second.getValue2(elevator.side);
+				}
+				
+				/*int maxRes = -100000;
+				int resFloor = -1;
+				for (int i = 0; i < LEVELS_COUNT; ++i)
+				{
+					int res = floorsPass[i] - std::abs(elevator.getFloor() - i) * 10;
+					if (res > maxRes)
+					{
+						maxRes = res;
+						resFloor = i;
+					}
+				}*/
+				
+				//std::cout << "TODO " << resFloor << std::endl;
+				
+				/*if (resFloor != -1)
+					goToFloor(elevator, resFloor);
+				else */if (dir == Direction::UP)
+					goToFloor(elevator, floor + 1);
+				else
+					goToFloor(elevator, floor - 1);
+			}
+		}
+		else if (go_to_floor != floor && sim.tick > 6500)
+		{
+			double timeToFloor = std::abs(go_to_floor - elevator.getFloor());
+			if (go_to_floor > elevator.getFloor())
+				timeToFloor *= 60;
+			else
+				timeToFloor *= 51;
+			timeToFloor += 241;
+			if (sim.tick + timeToFloor >= 7200)
+				goToFloor(elevator, go_to_floor);
+		}
+	}
+	
+	void recalcDestinationBeforeDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy);
+	//bool recalcDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy);
+	
+	void goToFloor(MyElevator &elevator, int go_to_floor)
+	{
+        if (go_to_floor > elevator.getFloor())
+            dir = Direction::UP;
+        else
+            dir = Direction::DOWN;
+        elevator.go_to_floor = go_to_floor;
+	}
+	
+	int invitePassengers(Simulator &sim, MyElevator &elevator)
+	{
+		int passCount = 0;
+		int floor = elevator.getFloor();
+		
+		bool anyEnemyElevatorsCloser = false;
+		bool anyElevatorsCloser = false;
+		for (MyElevator &e : sim.elevators)
+		{
+			if (e.id != elevator.id && e.ind <= elevator.ind && e.state == EState::FILLING && e.getFloor() == floor && e.side != elevator.side)
+			{
+				anyEnemyElevatorsCloser = true;
+			}
+			if (e.id != elevator.id && e.ind <= elevator.ind && e.state == EState::FILLING && e.getFloor() == floor)
+			{
+				anyElevatorsCloser = true;
+			}
+		}
+		
+		//std::bitset<LEVELS_COUNT> levels;
+		
+		std::multimap<int, MyPassenger *> passengers;
+		
+		for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+        {
+            MyPassenger &passenger = passengerEntry.second;
+            int dest_floor = passenger.dest_floor;
+			
+			if (std::abs(dest_floor - passenger.from_floor) <= 1)
+				continue;
+			
+			/*if (elevator.time_on_the_floor_with_opened_doors < 40 && passenger.side != elevator.side)
+				continue;*/
+			
+			/*if (sim.tick > 6500 && elevator.ind == 3 && passenger.dest_floor != 0)
+				continue;*/
+			
+            //if (dir == Direction::UP && passenger.dest_floor > passenger.from_floor || dir == Direction::DOWN && passenger.dest_floor < passenger.from_floor)
+            {
+				if (floor == 0 && dirChanges == 0 && dest_floor <= firstMoveMinDest && sim.tick < 1980)
+					continue;
+				
+                if (passenger.getFloor() == floor)
+				{
+					if (passenger.state == PState::WAITING_FOR_ELEVATOR || passenger.state == PState::RETURNING)
+					{
+						/*if (passenger.dest_floor == 0)
+						{
+							passenger.set_elevator.insert(elevator.id);
+							++passCount;
+						}
+						else
+						{*/
+							passengers.insert(std::make_pair(passenger.getValue(side), &passenger));
+						//}
+					}
+					else if (passenger.state == PState::MOVING_TO_ELEVATOR && passenger.elevator == elevator.id)
+					{
+						++passCount;
+						//levels.set(dest_floor);
+					}
+				}
+            }
+        }
+		
+		//double maxDist = 0;
+		//if (!anyElevatorsCloser)
+		{
+			int limit = MAX_PASSENGERS - (int) elevator.passengers.size() - passCount;
+			if (anyEnemyElevatorsCloser || elevator.ind == 3 && anyElevatorsCloser)
+				limit += 3;
+			
+			for (auto it = passengers.rbegin(); it != passengers.rend(); ++it)
+			{
+				if (limit <= 0)
+					break;
+				
+				if (limit <= 2 && it->first < 30 || limit <= 4 && it->first < 20)
+					continue;
+				
+				it->second->set_elevator.insert(elevator.id);
+				++passCount;
+				
+				--limit;
+				
+				//maxDist = std::max(maxDist, std::abs(it->second->x - (double) elevator.x));
+			}
+			
+			/*for (auto it = passengers.rbegin(); it != passengers.rend(); ++it)
+			{
+				double dist = std::abs(it->second->x - (double) elevator.x);
+				if (dist > maxDist)
+					it->second->set_elevator.insert(elevator.id);
+			}*/
+		}
+		
+        return passCount;
+	}
+};
+
+class MyStrategy
+{
+public:
+	Side side;
+	Simulator sim;
+	ElevatorStrategyUpDown strategy1;
+	ElevatorStrategyUpDown strategy2;
+	ElevatorStrategyUpDown strategy3;
+	ElevatorStrategyUpDown strategy4;
+
+    MyStrategy(Side side);
+    ~MyStrategy();
+	
+	void makeMove(Simulator &inputSim);
+	void makeMove();
+};
+
+HEADER_OLNY_INLINE int getNearestToLevelDestination(Simulator &sim, MyElevator& elevator, int level)
+{
+    int delta = 1000;
+    int targetFloor = level;
+    for (int id : elevator.passengers)
+    {
+        MyPassenger &pass = sim.passengers[id];
+        int d = std::abs(level - pass.dest_floor);
+        if (d < delta)
+        {
+            delta = d;
+            targetFloor = pass.dest_floor;
+        }
+    }
+    
+    if (targetFloor == level)
+	{
+		return sim.random.get_random() % 8 + 1;
+	}
+
+    return targetFloor;
+}
+
+HEADER_OLNY_INLINE int getNearestToLevelDestinationNoRand(Simulator &sim, MyElevator& elevator, int level)
+{
+    int targetFloor = level;
+
+	std::map<int, int> points;
+	
+    for (int id : elevator.passengers)
+    {
+        MyPassenger &pass = sim.passengers[id];
+		points[pass.dest_floor] -= pass.getValue(elevator.side);
+    }
+    
+    /*for (std::pair<const int, MyPassenger> &p : sim.outPassengers)
+	{
+		int floor = p.second.getFloor();
+		if (floor != level)
+		{
+			int pts = -10;
+			if (p.second.side != elevator.side)
+				pts *= 2;
+			if (points.count(floor))
+				points[floor] += pts;
+		}
+	}*/
+	// 0 RES: 1.06403 9456 10061.5 rem 1683.2 997.2 W 76 L 24 GOOD!
+	// 30 RES: 1.03688 9647.1 10002.9 rem 1680 1098.9 W 59 L 40 GOOD
+	// 10 RES: 1.04705 9618.8 10071.4 rem 1738.1 973.5 W 62 L 37 GOOD
+	// 1 RES: 1.04413 9608.1 10032.1 rem 1668.4 974.9 W 69 L 30 GOOD
+
+    auto x = std::min_element(points.begin(), points.end(),
+    [level](const std::pair<int, int>& p1, const std::pair<int, int>& p2) {
+        return (p1.second + 70*std::abs(level - p1.first)) < (p2.second + 70*std::abs(level - p2.first)); });
+
+	if (x != points.end())
+		return x->first;
+	
+    return targetFloor;
+}
+
+HEADER_OLNY_INLINE MyStrategy::MyStrategy(Side side) : side(side)
+{
+	strategy1.side = side;
+	strategy2.side = side;
+	strategy3.side = side;
+	strategy4.side = side;
+	
+	strategy1.firstMoveMinDest = 6;
+	strategy2.firstMoveMinDest = 5;
+	strategy3.firstMoveMinDest = 3;
+	strategy4.firstMoveMinDest = 2;
+}
+
+HEADER_OLNY_INLINE MyStrategy::~MyStrategy()
+{
+
+}
+
+HEADER_OLNY_INLINE void MyStrategy::makeMove()
+{
+	for (MyElevator & elevator : sim.elevators)
+    {
+        if (elevator.side == side && elevator.ind == 0)
+        {
+			strategy1.makeMove(sim, elevator, this);
+        }
+        else if (elevator.side == side && elevator.ind == 1)
+        {
+			strategy2.makeMove(sim, elevator, this);
+        }
+        else if (elevator.side == side && elevator.ind == 2)
+        {
+			strategy3.makeMove(sim, elevator, this);
+        }
+        else if (elevator.side == side && elevator.ind == 3)
+        {
+			strategy4.makeMove(sim, elevator, this);
+		}
+    }
+}
+
+HEADER_OLNY_INLINE void MyStrategy::makeMove(Simulator &inputSim)
+{
+    sim.synchronizeWith(inputSim);
+    makeMove();
+    inputSim.copyCommandsFrom(sim, side);
+    sim.step();
+}
+
+HEADER_OLNY_INLINE void ElevatorStrategyUpDown::recalcDestinationBeforeDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+{
+	int res = -100000;
+	int targetFloor = -1;
+	
+	Side enemySide = inverseSide(strategy->side);
+	int maxTicks = 7200 - sim.tick - 2;
+	float coef = 1.0;
+	if (maxTicks < 1500)
+		coef = ((float)maxTicks - 300.0f) / 1200.0f;
+	
+	/*double maxTick = 0;
+	for (int i = 0; i < LEVELS_COUNT; ++i)
+	{
+		if (i != elevator.getFloor())
+		{
+			int t;
+			if ( i > elevator.getFloor())
+				t = (i - elevator.getFloor()) / elevator.speed;
+			else
+				t = (elevator.getFloor() - i) * 50;
+			
+			if (t > maxTick)
+			{
+				maxTick = t;
+			}
+		}
+	}*/
+	
+	for (int i = 0; i < LEVELS_COUNT; ++i)
+	{
+		if (i != elevator.getFloor())
+		{
+			MyStrategy copy = *strategy;
+			copy.strategy1.doPredictions = false;
+			copy.strategy2.doPredictions = false;
+			copy.strategy3.doPredictions = false;
+			copy.strategy4.doPredictions = false;
+			
+			MyElevator &el = copy.sim.elevators[elevator.id];
+			el.go_to_floor = i;
+			
+			int tick = 0;
+			for (; tick < std::min(400 + elevator.ind * 40, maxTicks); ++tick)
+			{
+				// RES: 1.01338 9188.43 9311.33 rem 1149.8 841.1 W 56.6667 L 43
+				// RES: 1.02037 9189.1 9376.3 rem 1146.83 780 W 60.3333 L 38.3333
+				// 450 RES: 1.01813 9555.4 9728.6 rem 1217.7 786.3 W 59 L 40
+				// 490 RES: 1.02894 9492.8 9767.5 rem 1179.4 798.6 W 64 L 36
+				// 500 RES: 1.01935 9535.6 9720.1 rem 1160.78 791.38 W 57.8 L 42
+				// 510 RES: 1.04185 9474.4 9870.9 rem 1180 778.8 W 63 L 37 GOOD
+				// 520 RES: 1.01404 9669.9 9805.7 rem 1163 843.3 W 54 L 46
+				//makeMoveSimple(enemySide, copy.sim);
+				copy.makeMove();
+				copy.sim.step();
+				
+				/*if (el.id == 4 && i == 7)
+					std::cout << "Y " << tick << " " << el.y << " " << getEStateName(el.state) << std::endl;*/
+				
+				if (el.state == EState::CLOSING && el.closing_or_opening_ticks == 98)
+				{
+					//std::cout << "RET << " << tick << std::endl;
+					//break;
+				}
+			}
+			
+			int valLeft = copy.sim.scores[0] + copy.sim.passengersTotal[0]*1 + copy.sim.totalCargoValue2(Side::LEFT).points*0.5 * coef;
+			int valRight = copy.sim.scores[1] + copy.sim.passengersTotal[1]*1 + copy.sim.totalCargoValue2(Side::RIGHT).points*0.5 * coef;
+		
+			
+			int points;
+			if (copy.side == Side::LEFT)
+				points = valLeft - valRight;
+			else
+				points = valRight - valLeft;
+			
+			
+			if (i == elevator.next_floor)
+				++points;
+			
+			//points -= std::abs(elevator.getFloor() - i)*30;
+			
+			//std::cout << "PTS " << i << " " << valLeft << " " << valRight << " " << points << std::endl;
+			//std::cout << "SCR " << i << " " << copy.sim.scores[0] << " " << copy.sim.scores[1] << " " << points << std::endl;
+			
+			for (MyElevator &e : sim.elevators)
+			{
+				if (e.id != elevator.id && e.state == EState::MOVING && e.next_floor == i)
+				{
+					if (e.side == elevator.side && e.ind < elevator.ind)
+					{
+						points -= 200;
+					}
+					/*else if (e.side != elevator.side && e.ind > elevator.ind)
+					{
+						points += 1;
+					}*/
+					
+					// 100 RES: 1.03208 9524.5 9830 rem 1188.2 796.4 W 66 L 34 GOOD
+					// 200 RES: 1.03209 9510.9 9816.1 rem 1200.2 766.5 W 69 L 30 GOOD
+					// 250 RES: 1.03163 9506 9806.7 rem 1194.1 778.1 W 68 L 31 GOOD
+				}
+			}
+			
+			//points -= tick * 0.5;
+			if (points > res)
+			{
+				res = points;
+				targetFloor = i;
+			}
+		}
+	}
+	
+	if (targetFloor != -1)
+	{
+		int prevTarget = elevator.next_floor;
+		elevator.go_to_floor = targetFloor;
+		//std::cout << " Target " << targetFloor << " OLD " << prevTarget << std::endl;
+	}
+}
+
+}
+
+namespace strat4559 { 
+  enum class Direction { 
+    UP, DOWN 
+}; 
+ 
+int getNearestToLevelDestination(Simulator &sim, MyElevator& elevator, int level); 
+int getNearestToLevelDestinationNoRand(Simulator &sim, MyElevator& elevator, int level); 
+ 
+class MyStrategy; 
+struct ElevatorStrategyUpDown 
+{ 
+  Side side; 
+  Direction dir = Direction::UP; 
+  int dirChanges = 0; 
+  int firstMoveMinDest = 0; 
+  bool doPredictions = true; 
+   
+  void makeMove(Simulator &sim, MyElevator &elevator, MyStrategy *strategy) 
+  { 
+    Direction old = dir; 
+    doMakeMove(sim, elevator, strategy); 
+    if (old != dir) 
+      ++dirChanges; 
+  } 
+   
+  void doMakeMove(Simulator &sim, MyElevator &elevator, MyStrategy *strategy) 
+  { 
+    if (dir == Direction::UP && elevator.getFloor() == (LEVELS_COUNT - 1)) 
+      dir = Direction::DOWN; 
+    else if (dir == Direction::DOWN && elevator.getFloor() == 0) 
+      dir = Direction::UP; 
+     
+    if (doPredictions && elevator.state == EState::CLOSING && elevator.closing_or_opening_ticks == 98) 
+    { 
+      recalcDestinationBeforeDoorsClose(sim, elevator, strategy); 
+      return; 
+    } 
+     
+    if (elevator.state != EState::FILLING) 
+      return; 
+     
+    Value value = sim.getCargoValue(elevator); 
+     
+    int floor = elevator.getFloor(); 
+     
+    if (elevator.passengers.size() == MAX_PASSENGERS) 
+    { 
+      int go_to_floor = strat4559::getNearestToLevelDestinationNoRand(sim, elevator, elevator.getFloor()); 
+      goToFloor(elevator, go_to_floor); 
+    } 
+     
+    int passCount = invitePassengers(sim, elevator); 
+    if (sim.tick < 1980 && floor == 0) 
+      ++passCount; 
+         
+    bool anyElevatorsCloserThanMe = false; 
+    for (MyElevator &otherEl : sim.elevators) 
+    { 
+      if (otherEl.side == side && otherEl.state == EState::FILLING && otherEl.getFloor() == floor && otherEl.ind < elevator.ind) 
+      { 
+        anyElevatorsCloserThanMe = true; 
+        break; 
+      } 
+    } 
+     
+        if (!passCount) 
+    { 
+      bool anyElevatorsCloser = false; 
+      /*for (MyElevator &e : sim.elevators) 
+      { 
+        if (e.id != elevator.id && e.ind < elevator.ind && e.state == EState::FILLING && e.getFloor() == floor && e.passengers.size() < 19) 
+        { 
+          anyElevatorsCloser = true; 
+        } 
+      }*/ 
+       
+      if (!anyElevatorsCloser) 
+      { 
+        //int maxWait = 300 - std::max(0, (int) (elevator.passengers.size()) - 12) * 25; 
+        int maxWait = 550 - std::max(0, (int) (elevator.passengers.size()) - 12) * 50; 
+        int ticksToWait = std::min(std::max(0, 7200 - sim.tick - value.ticks), maxWait); 
+        //std::cout << "Wait " << ticksToWait << std::endl; 
+         
+        // 450 RES: 0.995443 9296.17 9253.8 rem 1138.53 1094.03 W 50.3333 L 49 
+        // 500 RES: 0.996442 9276.03 9243.03 rem 1120.8 1096.4 W 52.3333 L 47 
+        // 550 RES: 0.994873 9211.97 9164.73 rem 1095.67 1100.7 W 52 L 47.3333 
+        // RES: 1.00964 9188.13 9276.73 rem 1109.53 1112.33 W 56 L 43 
+         
+        int t = -1; 
+        for (auto && p = sim.outPassengers.begin(); p != sim.outPassengers.upper_bound(sim.tick + ticksToWait); ++p) 
+        { 
+          if (p->second.getFloor() == floor) 
+          { 
+            ++passCount; 
+            if (t == -1) 
+              t = p->first; 
+          } 
+        } 
+      } 
+    } 
+     
+    // RES: 0.994943 8661.2 8617.4 rem 953.7 944.5 W 39 L 35 
+    // 100 RES: 1.0044 8900.5 8939.7 rem 987.4 981.3 W 44 L 37 
+    // 200 RES: 1.01427 8606.9 8729.7 rem 967.7 899.7 W 41 L 25 
+    // 300 RES: 1.00729 8577.4 8639.9 rem 927.7 896.5 W 36 L 27 
+    // 400 RES: 1.00842 8525.4 8597.2 rem 936.3 866.2 W 34 L 29 
+     
+     
+    int go_to_floor = strat4559::getNearestToLevelDestinationNoRand(sim, elevator, elevator.getFloor()); 
+     
+    if (!passCount/* && elevator.time_on_the_floor_with_opened_doors >= 40*/) 
+    { 
+      if (go_to_floor != floor) 
+      { 
+        goToFloor(elevator, go_to_floor); 
+      } 
+      else 
+      { 
+        int floorsPass[LEVELS_COUNT] = {}; 
+        for (auto && p = sim.outPassengers.begin(); p != sim.outPassengers.upper_bound(sim.tick + 800); ++p) 
+        { 
+          floorsPass[p->second.getFloor()] += p->second.getValue2(elevator.side); 
+        } 
+         
+        /*int maxRes = -100000; 
+        int resFloor = -1; 
+        for (int i = 0; i < LEVELS_COUNT; ++i) 
+        { 
+          int res = floorsPass[i] - std::abs(elevator.getFloor() - i) * 10; 
+          if (res > maxRes) 
+          { 
+            maxRes = res; 
+            resFloor = i; 
+          } 
+        }*/ 
+         
+        //std::cout << "TODO " << resFloor << std::endl; 
+         
+        /*if (resFloor != -1) 
+          goToFloor(elevator, resFloor); 
+        else */if (dir == Direction::UP) 
+          goToFloor(elevator, floor + 1); 
+        else 
+          goToFloor(elevator, floor - 1); 
+      } 
+    } 
+    else if (go_to_floor != floor && sim.tick > 6500) 
+    { 
+      double timeToFloor = std::abs(go_to_floor - elevator.getFloor()); 
+      if (go_to_floor > elevator.getFloor()) 
+        timeToFloor *= 60; 
+      else 
+        timeToFloor *= 51; 
+      timeToFloor += 241; 
+      if (sim.tick + timeToFloor >= 7200) 
+        goToFloor(elevator, go_to_floor); 
+    } 
+  } 
+   
+  void recalcDestinationBeforeDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy); 
+  //bool recalcDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy); 
+   
+  void goToFloor(MyElevator &elevator, int go_to_floor) 
+  { 
+        if (go_to_floor > elevator.getFloor()) 
+            dir = Direction::UP; 
+        else 
+            dir = Direction::DOWN; 
+        elevator.go_to_floor = go_to_floor; 
+  } 
+   
+  int invitePassengers(Simulator &sim, MyElevator &elevator) 
+  { 
+    int passCount = 0; 
+    int floor = elevator.getFloor(); 
+     
+    bool anyEnemyElevatorsCloser = false; 
+    bool anyElevatorsCloser = false; 
+    for (MyElevator &e : sim.elevators) 
+    { 
+      if (e.id != elevator.id && e.ind <= elevator.ind && e.state == EState::FILLING && e.getFloor() == floor && e.side != elevator.side) 
+      { 
+        anyEnemyElevatorsCloser = true; 
+      } 
+      if (e.id != elevator.id && e.ind <= elevator.ind && e.state == EState::FILLING && e.getFloor() == floor) 
+      { 
+        anyElevatorsCloser = true; 
+      } 
+    } 
+     
+    //std::bitset<LEVELS_COUNT> levels; 
+     
+    std::multimap<int, MyPassenger *> passengers; 
+     
+    for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers) 
+        { 
+            MyPassenger &passenger = passengerEntry.second; 
+            int dest_floor = passenger.dest_floor; 
+       
+      if (std::abs(dest_floor - passenger.from_floor) <= 1) 
+        continue; 
+       
+      /*if (elevator.time_on_the_floor_with_opened_doors < 40 && passenger.side != elevator.side) 
+        continue;*/ 
+       
+      /*if (sim.tick > 6500 && elevator.ind == 3 && passenger.dest_floor != 0) 
+        continue;*/ 
+       
+            //if (dir == Direction::UP && passenger.dest_floor > passenger.from_floor || dir == Direction::DOWN && passenger.dest_floor < passenger.from_floor) 
+            { 
+        if (floor == 0 && dirChanges == 0 && dest_floor <= firstMoveMinDest && sim.tick < 1980) 
+          continue; 
+         
+                if (passenger.getFloor() == floor) 
+        { 
+          if (passenger.state == PState::WAITING_FOR_ELEVATOR || passenger.state == PState::RETURNING) 
+          { 
+            /*if (passenger.dest_floor == 0) 
+            { 
+              passenger.set_elevator.insert(elevator.id); 
+              ++passCount; 
+            } 
+            else 
+            {*/ 
+              passengers.insert(std::make_pair(passenger.getValue(side), &passenger)); 
+            //} 
+          } 
+          else if (passenger.state == PState::MOVING_TO_ELEVATOR && passenger.elevator == elevator.id) 
+          { 
+            ++passCount; 
+            //levels.set(dest_floor); 
+          } 
+        } 
+            } 
+        } 
+     
+    //double maxDist = 0; 
+    //if (!anyElevatorsCloser) 
+    { 
+      int limit = MAX_PASSENGERS - (int) elevator.passengers.size() - passCount; 
+      if (anyEnemyElevatorsCloser || elevator.ind == 3 && anyElevatorsCloser) 
+        limit += 3; 
+       
+      for (auto it = passengers.rbegin(); it != passengers.rend(); ++it) 
+      { 
+        if (limit <= 0) 
+          break; 
+         
+        if (limit <= 2 && it->first < 30 || limit <= 4 && it->first < 20) 
+          continue; 
+         
+        it->second->set_elevator.insert(elevator.id); 
+        ++passCount; 
+         
+        --limit; 
+         
+        //maxDist = std::max(maxDist, std::abs(it->second->x - (double) elevator.x)); 
+      } 
+       
+      /*for (auto it = passengers.rbegin(); it != passengers.rend(); ++it) 
+      { 
+        double dist = std::abs(it->second->x - (double) elevator.x); 
+        if (dist > maxDist) 
+          it->second->set_elevator.insert(elevator.id); 
+      }*/ 
+    } 
+     
+        return passCount; 
+  } 
+}; 
+ 
+class MyStrategy 
+{ 
+public: 
+  Side side; 
+  Simulator sim; 
+  ElevatorStrategyUpDown strategy1; 
+  ElevatorStrategyUpDown strategy2; 
+  ElevatorStrategyUpDown strategy3; 
+  ElevatorStrategyUpDown strategy4; 
+ 
+    MyStrategy(Side side); 
+    ~MyStrategy(); 
+   
+  void makeMove(Simulator &inputSim); 
+  void makeMove(); 
+}; 
+ 
+HEADER_OLNY_INLINE int getNearestToLevelDestination(Simulator &sim, MyElevator& elevator, int level) 
+{ 
+    int delta = 1000; 
+    int targetFloor = level; 
+    for (int id : elevator.passengers) 
+    { 
+        MyPassenger &pass = sim.passengers[id]; 
+        int d = std::abs(level - pass.dest_floor); 
+        if (d < delta) 
+        { 
+            delta = d; 
+            targetFloor = pass.dest_floor; 
+        } 
+    } 
+     
+    if (targetFloor == level) 
+  { 
+    return sim.random.get_random() % 8 + 1; 
+  } 
+ 
+    return targetFloor; 
+} 
+ 
+HEADER_OLNY_INLINE int getNearestToLevelDestinationNoRand(Simulator &sim, MyElevator& elevator, int level) 
+{ 
+    int targetFloor = level; 
+ 
+  std::map<int, int> points; 
+  std::map<int, int> destNum; 
+   
+    for (int id : elevator.passengers) 
+    { 
+        MyPassenger &pass = sim.passengers[id]; 
+    points[pass.dest_floor] -= pass.getValue(elevator.side); 
+    destNum[pass.dest_floor]++; 
+    } 
+     
+    for (std::pair<const int, int> &p : destNum) 
+  { 
+    int k = p.second; 
+    if (k > 1) 
+    { 
+      if (k == 2) 
+        points[p.first] -= 10.0; 
+      else if (k == 3) 
+        points[p.first] -= 20.0; 
+      else if (k == 4) 
+        points[p.first] -= 40.0; 
+      else 
+        points[p.first] -= (40 + (k - 4) * 30); 
+    } 
+  } 
+ 
+    auto x = std::min_element(points.begin(), points.end(), 
+    [level](const std::pair<int, int>& p1, const std::pair<int, int>& p2) { 
+        return (p1.second + 70*std::abs(level - p1.first)) < (p2.second + 70*std::abs(level - p2.first)); }); 
+ 
+  if (x != points.end()) 
+    return x->first; 
+   
+    return targetFloor; 
+} 
+ 
+HEADER_OLNY_INLINE MyStrategy::MyStrategy(Side side) : side(side) 
+{ 
+  strategy1.side = side; 
+  strategy2.side = side; 
+  strategy3.side = side; 
+  strategy4.side = side; 
+   
+  strategy1.firstMoveMinDest = 6; 
+  strategy2.firstMoveMinDest = 5; 
+  strategy3.firstMoveMinDest = 3; 
+  strategy4.firstMoveMinDest = 2; 
+} 
+ 
+HEADER_OLNY_INLINE MyStrategy::~MyStrategy() 
+{ 
+ 
+} 
+ 
+HEADER_OLNY_INLINE void MyStrategy::makeMove() 
+{ 
+  for (MyElevator & elevator : sim.elevators) 
+    { 
+        if (elevator.side == side && elevator.ind == 0) 
+        { 
+      strategy1.makeMove(sim, elevator, this); 
+        } 
+        else if (elevator.side == side && elevator.ind == 1) 
+        { 
+      strategy2.makeMove(sim, elevator, this); 
+        } 
+        else if (elevator.side == side && elevator.ind == 2) 
+        { 
+      strategy3.makeMove(sim, elevator, this); 
+        } 
+        else if (elevator.side == side && elevator.ind == 3) 
+        { 
+      strategy4.makeMove(sim, elevator, this); 
+    } 
+    } 
+} 
+ 
+HEADER_OLNY_INLINE void MyStrategy::makeMove(Simulator &inputSim) 
+{ 
+    sim.synchronizeWith(inputSim); 
+    makeMove(); 
+    inputSim.copyCommandsFrom(sim, side); 
+    sim.step(); 
+} 
+ 
+HEADER_OLNY_INLINE void ElevatorStrategyUpDown::recalcDestinationBeforeDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy) 
+{ 
+  int res = -100000; 
+  int targetFloor = -1; 
+   
+  Side enemySide = inverseSide(strategy->side); 
+  int maxTicks = 7200 - sim.tick - 2; 
+  float coef = 1.0; 
+  if (maxTicks < 1500) 
+    coef = ((float)maxTicks - 300.0f) / 1200.0f; 
+     
+  for (int i = 0; i < LEVELS_COUNT; ++i) 
+  { 
+    if (i != elevator.getFloor()) 
+    { 
+      MyStrategy copy = *strategy; 
+      copy.strategy1.doPredictions = false; 
+      copy.strategy2.doPredictions = false; 
+      copy.strategy3.doPredictions = false; 
+      copy.strategy4.doPredictions = false; 
+       
+      MyElevator &el = copy.sim.elevators[elevator.id]; 
+      el.go_to_floor = i; 
+       
+      int tick = 0; 
+      for (; tick < std::min(400 + elevator.ind * 40, maxTicks); ++tick) 
+      { 
+        //makeMoveSimple(enemySide, copy.sim); 
+        copy.makeMove(); 
+        copy.sim.step(); 
+                 
+        if (el.state == EState::CLOSING && el.closing_or_opening_ticks == 98) 
+        { 
+          //std::cout << "RET << " << tick << std::endl; 
+          //break; 
+        } 
+      } 
+       
+      int points; 
+       
+      if (false && sim.tick < 5900) 
+      { 
+        double newPassVal = 0.0; 
+        int passGone = 0; 
+         
+        double passCount[LEVELS_COUNT]; 
+        for (int k = 0; k < LEVELS_COUNT; ++k) 
+          passCount[k] = 0.0; 
+         
+        for (int id : el.passengers) 
+        { 
+          MyPassenger &pass = copy.sim.passengers[id]; 
+          if (!elevator.passengers.count(id)) 
+          { 
+            newPassVal += pass.getValue2(elevator.side); 
+          } 
+        } 
+         
+        points = newPassVal; 
+         
+        for (int id : elevator.passengers) 
+        { 
+          if (!el.passengers.count(id)) 
+          { 
+            ++passGone; 
+          } 
+        } 
+         
+        if (passGone > 2) 
+        { 
+          points += (passGone - 2) * 30; 
+        } 
+        else if (passGone <= 1) 
+        { 
+          points -= 110; 
+        } 
+         
+        if (passGone < 11 && i == 0) 
+          points -= 1000; 
+      } 
+      else 
+      { 
+        int valLeft, valRight; 
+        valLeft = copy.sim.scores[0] + copy.sim.passengersTotal[0]*1 + copy.sim.totalCargoValue2(Side::LEFT).points*0.5 * coef; 
+        valRight = copy.sim.scores[1] + copy.sim.passengersTotal[1]*1 + copy.sim.totalCargoValue2(Side::RIGHT).points*0.5 * coef; 
+         
+        if (copy.side == Side::LEFT) 
+          points = valLeft - valRight; 
+        else 
+          points = valRight - valLeft; 
+         
+         
+        int passGone = 0; 
+        for (int id : elevator.passengers) 
+        { 
+          if (!el.passengers.count(id)) 
+          { 
+            ++passGone; 
+          } 
+        } 
+         
+        if (passGone < 10 && i == 0) 
+          points -= 100; 
+      } 
+       
+      if (i == elevator.next_floor) 
+        ++points; 
+       
+      for (MyElevator &e : sim.elevators) 
+      { 
+        if (e.id != elevator.id && e.state == EState::MOVING && e.next_floor == i) 
+        { 
+          if (e.side == elevator.side && e.ind < elevator.ind) 
+          { 
+            points -= 200; 
+          } 
+        } 
+      } 
+       
+      if (points > res) 
+      { 
+        res = points; 
+        targetFloor = i; 
+      } 
+    } 
+  } 
+   
+  if (targetFloor != -1) 
+  { 
+    int prevTarget = elevator.next_floor; 
+    elevator.go_to_floor = targetFloor; 
+    //std::cout << " Target " << targetFloor << " OLD " << prevTarget << std::endl; 
+  } 
+} 
+}
+
+namespace strat4932 {
+	enum class Direction {
+    UP, DOWN
+};
+
+int getNearestToLevelDestination(Simulator &sim, MyElevator& elevator, int level);
+int getNearestToLevelDestinationNoRand(Simulator &sim, MyElevator& elevator, int level);
+
+class MyStrategy;
+struct ElevatorStrategyUpDown
+{
+	Side side;
+	Direction dir = Direction::UP;
+	int dirChanges = 0;
+	int firstMoveMinDest = 0;
+	bool doPredictions = true;
+	
+	void makeMove(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+	{
+		Direction old = dir;
+		doMakeMove(sim, elevator, strategy);
+		if (old != dir)
+			++dirChanges;
+	}
+	
+	void doMakeMove(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+	{
+		if (dir == Direction::UP && elevator.getFloor() == (LEVELS_COUNT - 1))
+			dir = Direction::DOWN;
+		else if (dir == Direction::DOWN && elevator.getFloor() == 0)
+			dir = Direction::UP;
+		
+		if (doPredictions && elevator.state == EState::CLOSING && elevator.closing_or_opening_ticks == 98)
+		{
+			recalcDestinationBeforeDoorsClose(sim, elevator, strategy);
+			return;
+		}
+		
+		if (elevator.state != EState::FILLING)
+			return;
+		
+		Value value = sim.getCargoValue(elevator);
+		
+		int floor = elevator.getFloor();
+		
+		if (elevator.passengers.size() == MAX_PASSENGERS && elevator.time_on_the_floor_with_opened_doors >= 40)
+		{
+			int go_to_floor = strat4932::getNearestToLevelDestinationNoRand(sim, elevator, elevator.getFloor());
+			goToFloor(elevator, go_to_floor);
+		}
+		
+		int passCount = invitePassengers(sim, elevator);
+		if (sim.tick < 1980 && floor == 0)
+			++passCount;
+        
+		bool anyElevatorsCloserThanMe = false;
+		for (MyElevator &otherEl : sim.elevators)
+		{
+			if (otherEl.side == side && otherEl.state == EState::FILLING && otherEl.getFloor() == floor && otherEl.ind < elevator.ind)
+			{
+				anyElevatorsCloserThanMe = true;
+				break;
+			}
+		}
+		
+        if (!passCount)
+		{
+			bool anyElevatorsCloser = false;
+			/*for (MyElevator &e : sim.elevators)
+			{
+				if (e.id != elevator.id && e.ind < elevator.ind && e.state == EState::FILLING && e.getFloor() == floor && e.passengers.size() < 19)
+				{
+					anyElevatorsCloser = true;
+				}
+			}*/
+			
+			if (!anyElevatorsCloser)
+			{
+				//int maxWait = 300 - std::max(0, (int) (elevator.passengers.size()) - 12) * 25;
+				int maxWait;
+				if (elevator.time_on_the_floor_with_opened_doors < 40)
+					maxWait = 630;
+				else
+					maxWait = 630 - std::max(0, (int) (elevator.passengers.size()) - 9) * 50;
+				
+				// 600 7*50 RES: 1.06206 10375.2 11019.1 rem 817.7 1285.5 W 72 L 28 GOOD!
+				// 600 8 50 RES: 1.07105 10244.1 10971.9 rem 833.9 1335.4 W 75 L 24 GOOD!
+				// 600 9 50 RES: 1.07693 10161.8 10943.5 rem 801 1342.8 W 82 L 18 GOOD!
+				// 620 9 50 RES: 1.07793 10141.9 10932.3 rem 842.4 1348.2 W 83 L 17 GOOD!
+				// 630 9 50 RES: 1.07779 10126.6 10914.3 rem 847.8 1374.3 W 84 L 16 GOOD!
+				// 600 9 55 RES: 1.07187 10227.1 10962.1 rem 818.9 1351.1 W 79 L 20 GOOD!
+				// 620 9 55 RES: 1.07481 10184.1 10946 rem 767.8 1360.6 W 81 L 19 GOOD!
+				// 630 9 55 RES: 1.07199 10189.6 10923.1 rem 798.5 1360.8 W 79 L 20 GOOD!
+				// 630 9 60 RES: 1.07513 10215.9 10983.4 rem 830 1335 W 78 L 21 GOOD!
+				// 10 50 RES: 1.05791 10207.7 10798.8 rem 832.3 1418.2 W 75 L 25 GOOD!
+				
+				int ticksToWait = std::min(std::max(0, 7200 - sim.tick - std::min(1200, value.ticks)), maxWait);
+				
+				// 1300 RES: 1.08322 10153.2 10998.2 rem 900 1232.8 W 83 L 16 GOOD!
+				// 1200 RES: 1.08367 10136.8 10984.9 rem 890.4 1263.6 W 84 L 15 GOOD!
+				// 1100 RES: 1.08038 10130.6 10944.9 rem 879.5 1313.5 W 84 L 16 GOOD!
+				// 1000 RES: 1.07779 10126.6 10914.3 rem 847.8 1374.3 W 84 L 16 GOOD!
+				// 900 RES: 1.07609 10130.1 10900.9 rem 839.1 1437.5 W 83 L 17 GOOD!
+				
+				// RES: 7 50  1.06206 10375.2 11019.1 rem 817.7 1285.5 W 72 L 28 GOOD!
+				
+				int t = -1;
+				for (auto && p = sim.outPassengers.begin(); p != sim.outPassengers.upper_bound(sim.tick + ticksToWait); ++p)
+				{
+					if (p->second.getFloor() == floor)
+					{
+						++passCount;
+						if (t == -1)
+							t = p->first;
+					}
+				}
+				
+				if (t > sim.tick + (250 + passCount * 60))
+				{
+					// RES: 400 *50  1.05554 10389 10966 rem 797.6 1291.3 W 72 L 28 GOOD!
+					// 300 50 RES: 1.0576 10393.3 10992 rem 788.9 1297.1 W 73 L 27 GOOD!
+					// 250 50 RES: 1.05988 10396.2 11018.7 rem 815.1 1298.6 W 72 L 28 GOOD!
+					// 250 55 RES: 1.06133 10379.1 11015.6 rem 815.7 1293.8 W 72 L 28 GOOD!
+					// 250 60 RES: 1.06206 10375.2 11019.1 rem 817.7 1285.5 W 72 L 28 GOOD!
+					// 250 65 RES: 1.05856 10392.5 11001.1 rem 796.9 1290.5 W 73 L 27 GOOD!
+					//std:: cout << (t - sim.tick) << " " << passCount << std::endl;
+					passCount = 0;
+				}
+				
+				/*if (elevator.ind == 0 && elevator.getFloor() == 8)
+					std::cout << sim.tick << " Wait " << ticksToWait << " pc " << passCount << " " << elevator.time_on_the_floor_with_opened_doors << " " << maxWait << " " << std::endl;*/
+			}
+		}
+		
+		// RES: 0.994943 8661.2 8617.4 rem 953.7 944.5 W 39 L 35
+		// 100 RES: 1.0044 8900.5 8939.7 rem 987.4 981.3 W 44 L 37
+		// 200 RES: 1.01427 8606.9 8729.7 rem 967.7 899.7 W 41 L 25
+		// 300 RES: 1.00729 8577.4 8639.9 rem 927.7 896.5 W 36 L 27
+		// 400 RES: 1.00842 8525.4 8597.2 rem 936.3 866.2 W 34 L 29
+		
+		
+		int go_to_floor = strat4932::getNearestToLevelDestinationNoRand(sim, elevator, elevator.getFloor());
+		
+		if (!passCount && elevator.time_on_the_floor_with_opened_doors >= 40)
+		{
+			if (go_to_floor != floor)
+			{
+				goToFloor(elevator, go_to_floor);
+			}
+			else
+			{
+				int floorsPass[LEVELS_COUNT] = {};
+				for (auto && p = sim.outPassengers.begin(); p != sim.outPassengers.upper_bound(sim.tick + 800); ++p)
+				{
+					floorsPass[p->second.getFloor()] += p->second.getValue2(elevator.side);
+				}
+				
+				/*int maxRes = -100000;
+				int resFloor = -1;
+				for (int i = 0; i < LEVELS_COUNT; ++i)
+				{
+					int res = floorsPass[i] - std::abs(elevator.getFloor() - i) * 10;
+					if (res > maxRes)
+					{
+						maxRes = res;
+						resFloor = i;
+					}
+				}*/
+				
+				//std::cout << "TODO " << resFloor << std::endl;
+				
+				/*if (resFloor != -1)
+					goToFloor(elevator, resFloor);
+				else */if (dir == Direction::UP)
+					goToFloor(elevator, floor + 1);
+				else
+					goToFloor(elevator, floor - 1);
+			}
+		}
+		else if (go_to_floor != floor && sim.tick > 6500)
+		{
+			double timeToFloor = std::abs(go_to_floor - elevator.getFloor());
+			if (go_to_floor > elevator.getFloor())
+				timeToFloor *= 60;
+			else
+				timeToFloor *= 51;
+			timeToFloor += 241;
+			if (sim.tick + timeToFloor >= 7200)
+				goToFloor(elevator, go_to_floor);
+		}
+	}
+	
+	void recalcDestinationBeforeDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy);
+	//bool recalcDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy);
+	
+	void goToFloor(MyElevator &elevator, int go_to_floor)
+	{
+        if (go_to_floor > elevator.getFloor())
+            dir = Direction::UP;
+        else
+            dir = Direction::DOWN;
+        elevator.go_to_floor = go_to_floor;
+		
+		//std::cout << "GT " << elevator.ind << " " << go_to_floor << std::endl;
+	}
+	
+	int invitePassengers(Simulator &sim, MyElevator &elevator)
+	{
+		int passCount = 0;
+		int floor = elevator.getFloor();
+		
+		bool anyEnemyElevatorsCloser = false;
+		bool anyElevatorsCloser = false;
+		for (MyElevator &e : sim.elevators)
+		{
+			if (e.id != elevator.id && e.ind <= elevator.ind && e.state == EState::FILLING && e.getFloor() == floor && e.side != elevator.side)
+			{
+				anyEnemyElevatorsCloser = true;
+			}
+			if (e.id != elevator.id && e.ind <= elevator.ind && e.state == EState::FILLING && e.getFloor() == floor)
+			{
+				anyElevatorsCloser = true;
+			}
+		}
+		
+		//std::bitset<LEVELS_COUNT> levels;
+		
+		std::multimap<int, MyPassenger *> passengers;
+		
+		for (std::pair<const int, MyPassenger> & passengerEntry : sim.passengers)
+        {
+            MyPassenger &passenger = passengerEntry.second;
+            int dest_floor = passenger.dest_floor;
+			
+			if (std::abs(dest_floor - passenger.from_floor) <= 1)
+				continue;
+			
+			/*if (elevator.time_on_the_floor_with_opened_doors < 40 && passenger.side != elevator.side)
+				continue;*/
+			
+			/*if (sim.tick > 6500 && elevator.ind == 3 && passenger.dest_floor != 0)
+				continue;*/
+			
+			bool our = passenger.side == elevator.side;
+            //if (dir == Direction::UP && passenger.dest_floor > passenger.from_floor || dir == Direction::DOWN && passenger.dest_floor < passenger.from_floor)
+            {
+				if (floor == 0 && dirChanges == 0 && dest_floor <= firstMoveMinDest && sim.tick < 1980)
+					continue;
+				
+                if (passenger.getFloor() == floor)
+				{
+					if (passenger.state == PState::WAITING_FOR_ELEVATOR || passenger.state == PState::RETURNING)
+					{
+						/*if (passenger.dest_floor == 0)
+						{
+							passenger.set_elevator.insert(elevator.id);
+							++passCount;
+						}
+						else
+						{*/
+							passengers.insert(std::make_pair(passenger.getValue(side), &passenger));
+						//}
+					}
+					else if (passenger.state == PState::MOVING_TO_ELEVATOR && passenger.elevator == elevator.id)
+					{
+						++passCount;
+						//levels.set(dest_floor);
+					}
+				}
+            }
+        }
+		
+		//double maxDist = 0;
+		//if (!anyElevatorsCloser)
+		{
+			int limit = MAX_PASSENGERS - (int) elevator.passengers.size() - passCount;
+			if (anyEnemyElevatorsCloser || elevator.ind == 3 && anyElevatorsCloser)
+				limit += 3;
+			
+			for (auto it = passengers.rbegin(); it != passengers.rend(); ++it)
+			{
+				if (limit <= 0)
+					break;
+				
+				if (limit <= 2 && it->first < 30 || limit <= 4 && it->first < 20)
+					continue;
+				
+				it->second->set_elevator.insert(elevator.id);
+				++passCount;
+				
+				--limit;
+				
+				//maxDist = std::max(maxDist, std::abs(it->second->x - (double) elevator.x));
+			}
+			
+			/*for (auto it = passengers.rbegin(); it != passengers.rend(); ++it)
+			{
+				double dist = std::abs(it->second->x - (double) elevator.x);
+				if (dist > maxDist)
+					it->second->set_elevator.insert(elevator.id);
+			}*/
+		}
+		
+        return passCount;
+	}
+};
+
+class MyStrategy
+{
+public:
+	Side side;
+	Simulator sim;
+	ElevatorStrategyUpDown strategy1;
+	ElevatorStrategyUpDown strategy2;
+	ElevatorStrategyUpDown strategy3;
+	ElevatorStrategyUpDown strategy4;
+
+    MyStrategy(Side side);
+    ~MyStrategy();
+	
+	void makeMove(Simulator &inputSim);
+	void makeMove();
+};
+
+
+HEADER_OLNY_INLINE int getNearestToLevelDestination(Simulator &sim, MyElevator& elevator, int level)
+{
+    int delta = 1000;
+    int targetFloor = level;
+    for (int id : elevator.passengers)
+    {
+        MyPassenger &pass = sim.passengers[id];
+        int d = std::abs(level - pass.dest_floor);
+        if (d < delta)
+        {
+            delta = d;
+            targetFloor = pass.dest_floor;
+        }
+    }
+    
+    if (targetFloor == level)
+	{
+		return sim.random.get_random() % 8 + 1;
+	}
+
+    return targetFloor;
+}
+
+HEADER_OLNY_INLINE int getNearestToLevelDestinationNoRand(Simulator &sim, MyElevator& elevator, int level)
+{
+    int targetFloor = level;
+
+	std::map<int, int> points;
+	std::map<int, int> destNum;
+	
+    for (int id : elevator.passengers)
+    {
+        MyPassenger &pass = sim.passengers[id];
+		points[pass.dest_floor] -= pass.getValue(elevator.side);
+		destNum[pass.dest_floor]++;
+    }
+    
+    for (std::pair<const int, int> &p : destNum)
+	{
+		int k = p.second;
+		if (k > 1)
+		{
+			if (k == 2)
+				points[p.first] -= 10.0;
+			else if (k == 3)
+				points[p.first] -= 20.0;
+			else if (k == 4)
+				points[p.first] -= 40.0;
+			else
+				points[p.first] -= (40 + (k - 4) * 30);
+		}
+	}
+
+    auto x = std::min_element(points.begin(), points.end(),
+    [level](const std::pair<int, int>& p1, const std::pair<int, int>& p2) {
+        return (p1.second + 70*std::abs(level - p1.first)) < (p2.second + 70*std::abs(level - p2.first)); });
+
+	if (x != points.end())
+		return x->first;
+	
+    return targetFloor;
+}
+
+HEADER_OLNY_INLINE MyStrategy::MyStrategy(Side side) : side(side)
+{
+	strategy1.side = side;
+	strategy2.side = side;
+	strategy3.side = side;
+	strategy4.side = side;
+	
+	strategy1.firstMoveMinDest = 6;
+	strategy2.firstMoveMinDest = 5;
+	strategy3.firstMoveMinDest = 3;
+	strategy4.firstMoveMinDest = 2;
+}
+
+HEADER_OLNY_INLINE MyStrategy::~MyStrategy()
+{
+
+}
+
+HEADER_OLNY_INLINE void MyStrategy::makeMove()
+{
+	for (MyElevator & elevator : sim.elevators)
+    {
+        if (elevator.side == side && elevator.ind == 0)
+        {
+			strategy1.makeMove(sim, elevator, this);
+        }
+        else if (elevator.side == side && elevator.ind == 1)
+        {
+			strategy2.makeMove(sim, elevator, this);
+        }
+        else if (elevator.side == side && elevator.ind == 2)
+        {
+			strategy3.makeMove(sim, elevator, this);
+        }
+        else if (elevator.side == side && elevator.ind == 3)
+        {
+			strategy4.makeMove(sim, elevator, this);
+		}
+    }
+}
+
+HEADER_OLNY_INLINE void MyStrategy::makeMove(Simulator &inputSim)
+{
+    sim.synchronizeWith(inputSim);
+    makeMove();
+    inputSim.copyCommandsFrom(sim, side);
+    sim.step();
+}
+
+HEADER_OLNY_INLINE void ElevatorStrategyUpDown::recalcDestinationBeforeDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+{
+	int res = -100000;
+	int targetFloor = -1;
+	
+	Side enemySide = inverseSide(strategy->side);
+	int maxTicks = 7200 - sim.tick - 2;
+	float coef = 1.0;
+	if (maxTicks < 1500)
+		coef = ((float)maxTicks - 300.0f) / 1200.0f;
+	
+	/*double maxTick = 0;
+	for (int i = 0; i < LEVELS_COUNT; ++i)
+	{
+		if (i != elevator.getFloor())
+		{
+			int t;
+			if ( i > elevator.getFloor())
+				t = (i - elevator.getFloor()) / elevator.speed;
+			else
+				t = (elevator.getFloor() - i) * 50;
+			
+			if (t > maxTick)
+			{
+				maxTick = t;
+			}
+		}
+	}*/
+	
+	for (int i = 0; i < LEVELS_COUNT; ++i)
+	{
+		if (i != elevator.getFloor())
+		{
+			MyStrategy copy = *strategy;
+			copy.strategy1.doPredictions = false;
+			copy.strategy2.doPredictions = false;
+			copy.strategy3.doPredictions = false;
+			copy.strategy4.doPredictions = false;
+			
+			MyElevator &el = copy.sim.elevators[elevator.id];
+			el.go_to_floor = i;
+			
+			int tick = 0;
+			for (; tick < std::min(400 + elevator.ind * 40, maxTicks); ++tick)
+			{
+				//makeMoveSimple(enemySide, copy.sim);
+				copy.makeMove();
+				copy.sim.step();
+								
+				if (el.state == EState::CLOSING && el.closing_or_opening_ticks == 98)
+				{
+					//std::cout << "RET << " << tick << std::endl;
+					//break;
+				}
+			}
+			
+			int points;
+			
+			if (false && sim.tick < 5900)
+			{
+				double newPassVal = 0.0;
+				int passGone = 0;
+				
+				double passCount[LEVELS_COUNT];
+				for (int k = 0; k < LEVELS_COUNT; ++k)
+					passCount[k] = 0.0;
+				
+				for (int id : el.passengers)
+				{
+					MyPassenger &pass = copy.sim.passengers[id];
+					if (!elevator.passengers.count(id))
+					{
+						newPassVal += pass.getValue2(elevator.side);
+					}
+					
+					/*if (pass.dest_floor_confirmed)
+					{
+						passCount[pass.dest_floor]++;
+					}
+					else
+					{
+						int cnt = pass.visitedLevels.count();
+						if (cnt < 1 || cnt > 6)
+							std::cout << "ERR invalid visitedLevels "  << cnt << std::endl;
+		
+						for (int i = 1; i < LEVELS_COUNT; ++i)
+						{
+							if (!pass.visitedLevels.test(i))
+							{
+								passCount[i] += (6 - cnt) * 0.2 / (double) (LEVELS_COUNT - cnt);
+							}
+						}
+						
+						passCount[0] += (cnt - 1) * 0.2;
+					}*/
+				}
+				
+				points = newPassVal;
+				
+				/*double totalGrouping = 0.0;
+				for (int k = 0; k < LEVELS_COUNT; ++k) {
+					double grouping = (std::pow(1.5, passCount[k]) - 1.0);
+					totalGrouping += grouping;
+					//std::cout << grouping << std::endl;
+				}
+				
+				//std::cout << "TG " << totalGrouping << std::endl;
+				points += totalGrouping * 0.5;*/
+				
+				for (int id : elevator.passengers)
+				{
+					if (!el.passengers.count(id))
+					{
+						++passGone;
+					}
+				}
+				
+				if (passGone > 2)
+				{
+					points += (passGone - 2) * 30;
+				}
+				else if (passGone <= 1)
+				{
+					points -= 110;
+					
+					// 110 1.03101 9297.9 9586.2 rem 907.2 865.1 W 63 L 36 GOOD
+				}
+				else if (passGone <= 2)
+				{
+					//points -= 30;
+					
+					// 50 RES: 1.02466 9323.2 9553.1 rem 915.8 884.7 W 61 L 38
+					// 40 RES: 1.02705 9308.6 9560.4 rem 909 842.7 W 62 L 37
+					// 30 RES: 1.03101 9297.9 9586.2 rem 907.2 865.1 W 63 L 36 GOOD
+					// 20 RES: 1.02309 9324.3 9539.6 rem 900.1 876.4 W 58 L 42
+				}
+				
+				// 10 RES: 1.0314 9374.7 9669.1 rem 955.6 920.7 W 66 L 34 GOOD
+				// 11 RES: 1.03258 9364.7 9669.8 rem 924.8 927.5 W 66 L 34 GOOD
+				// 12 RES: 1.03253 9357.6 9662 rem 926.1 923.3 W 66 L 34 GOOD
+				// 15 RES: 1.02841 9359.6 9625.5 rem 951.3 904.8 W 64 L 36
+				if (passGone < 11 && i == 0)
+					points -= 1000;
+				
+				// 90 RES: 1.00636 9419.9 9479.8 rem 914.5 973.1 W 54 L 46
+				// 100 RES: 1.01301 9357.4 9479.1 rem 925.3 941.1 W 57 L 42
+				// 110 RES: 1.01467 9380.5 9518.1 rem 901.5 928 W 60 L 40
+				// 120 RES: 1.00926 9379.8 9466.7 rem 891.4 933.9 W 56 L 44
+			}
+			else
+			{
+				int valLeft, valRight;
+				valLeft = copy.sim.scores[0] + copy.sim.passengersTotal[0]*1 + copy.sim.totalCargoValue2(Side::LEFT).points*0.5 * coef;
+				valRight = copy.sim.scores[1] + copy.sim.passengersTotal[1]*1 + copy.sim.totalCargoValue2(Side::RIGHT).points*0.5 * coef;
+				
+				if (copy.side == Side::LEFT)
+					points = valLeft - valRight;
+				else
+					points = valRight - valLeft;
+				
+				
+				int passGone = 0;
+				for (int id : elevator.passengers)
+				{
+					if (!el.passengers.count(id))
+					{
+						++passGone;
+					}
+				}
+				
+				if (passGone < 10 && i == 0)
+					points -= 100;
+			}
+			
+			if (i == elevator.next_floor)
+				++points;
+			
+			//points -= std::abs(elevator.getFloor() - i)*30;
+			
+			//std::cout << "PTS " << i << " " << valLeft << " " << valRight << " " << points << std::endl;
+			//std::cout << "SCR " << i << " " << copy.sim.scores[0] << " " << copy.sim.scores[1] << " " << points << std::endl;
+			
+			for (MyElevator &e : sim.elevators)
+			{
+				if (e.id != elevator.id && e.state == EState::MOVING && e.next_floor == i)
+				{
+					if (e.side == elevator.side && e.ind < elevator.ind)
+					{
+						points -= 200;
+					}
+					/*else if (e.side != elevator.side && elevator.passengers.size() < 10)
+					{
+						double enemy_ttf = e.time_to_floor;
+						double my_ttf = elevator.calcTimeToFloor(i, sim);
+						if (enemy_ttf > my_ttf + 45 && enemy_ttf < my_ttf + 145)
+						{
+							bool anyOtherEl = false;
+							for (MyElevator &o : sim.elevators)
+							{
+								if (o.id != elevator.id && o.id != e.id)
+								{
+									if (o.state == EState::MOVING && e.next_floor == i && e.time_to_floor < my_ttf ||
+										(o.state == EState::OPENING || o.state == EState::WAITING) && o.getFloor() == i
+									)
+									{
+										anyOtherEl = true;
+										break;
+									}
+								}
+							}
+							
+							if (!anyOtherEl)
+							{
+								int floorPassCount = 0;
+								for (auto && p = sim.outPassengers.begin(); p != sim.outPassengers.upper_bound(sim.tick + my_ttf + 145); ++p)
+								{
+									if (p->second.getFloor() == i && (p->first + p->second.time_to_away) > (sim.tick + my_ttf + 105) && (p->first) < (sim.tick + my_ttf + 145))
+									{
+										++floorPassCount;
+									}
+								}
+								if (floorPassCount >= 10)
+								{
+									//std::cout << "YY " << i << " et " << enemy_ttf << " mt " << my_ttf << " e " << e.ind << " mi " << elevator.ind << " pp " << floorPassCount << std::endl;
+									//points += std::min(floorPassCount, (int) (20 - elevator.passengers.size())) * 20;
+								}
+							}
+						}
+					}*/
+					
+					// 100 RES: 1.03208 9524.5 9830 rem 1188.2 796.4 W 66 L 34 GOOD
+					// 200 RES: 1.03209 9510.9 9816.1 rem 1200.2 766.5 W 69 L 30 GOOD
+					// 250 RES: 1.03163 9506 9806.7 rem 1194.1 778.1 W 68 L 31 GOOD
+				}
+			}
+			
+			//points -= tick * 0.5;
+			if (points > res)
+			{
+				res = points;
+				targetFloor = i;
+			}
+		}
+	}
+	
+	if (targetFloor != -1)
+	{
+		int prevTarget = elevator.next_floor;
+		elevator.go_to_floor = targetFloor;
+		//std::cout << " Target " << targetFloor << " OLD " << prevTarget << std::endl;
+	}
+}
+}
+
+#endif
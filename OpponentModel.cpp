@@ -0,0 +1,134 @@
+#ifndef HEADER_OLNY_INLINE
+#include "OpponentModel.hpp"
+#endif
+#include <cstring>
+
+#ifndef HEADER_OLNY_INLINE
+#define HEADER_OLNY_INLINE
+#define HEADER_OLNY_STATIC
+#endif
+
+HEADER_OLNY_STATIC const char * OPPONENT_MODEL_NAMES[] = {
+	"idle",
+	"sweeper",
+	"mirror"
+};
+
+// Extra cost of a rollout tick over idle, the mean over the game stages of
+// bench --filter rollout_tick --min-time 1000, p50 ns per tick early/mid/late:
+// idle 2880/6530/544, sweeper 3200/6910/800 (+0.11/+0.06/+0.47),
+// mirror 5120/13310/1056 (+0.78/+1.04/+0.94)
+HEADER_OLNY_STATIC const double OPPONENT_MODEL_COSTS[] = {
+	0.0,
+	0.2,
+	0.9
+};
+
+HEADER_OLNY_INLINE const char * getOpponentModelName(OpponentModelType type)
+{
+	return OPPONENT_MODEL_NAMES[(int) type];
+}
+
+HEADER_OLNY_INLINE OpponentModelType getOpponentModelType(const char *name)
+{
+	for (int i = 0; i < (int) OpponentModelType::COUNT; ++i)
+	{
+		if (!strcmp(OPPONENT_MODEL_NAMES[i], name))
+			return (OpponentModelType) i;
+	}
+	return OpponentModelType::COUNT;
+}
+
+HEADER_OLNY_INLINE double getOpponentModelCost(OpponentModelType type)
+{
+	return OPPONENT_MODEL_COSTS[(int) type];
+}
+
+HEADER_OLNY_INLINE std::unique_ptr<OpponentModel> createOpponentModel(OpponentModelType type, Side side, const StrategyParams &params)
+{
+	if (type == OpponentModelType::SWEEPER)
+		return std::unique_ptr<OpponentModel>(new SweeperOpponent(side));
+	if (type == OpponentModelType::MIRROR)
+		return std::unique_ptr<OpponentModel>(new MirrorOpponent(side, params));
+	return std::unique_ptr<OpponentModel>();
+}
+
+// Next floor of a sweep by direction, the ends turn back
+HEADER_OLNY_STATIC const int8_t SWEEP_NEXT_FLOOR[2][LEVELS_COUNT] = {
+	{1, 0, 1, 2, 3, 4, 5, 6, 7},  // down
+	{1, 2, 3, 4, 5, 6, 7, 8, 7}   // up
+};
+
+HEADER_OLNY_INLINE SweeperOpponent::SweeperOpponent(Side side) : side(side)
+{
+	for (bool &u : up)
+		u = true;
+}
+
+HEADER_OLNY_INLINE void SweeperOpponent::makeMove(Simulator &sim)
+{
+	int fillingOn[LEVELS_COUNT];
+	bool anyFilling = false;
+	for (int &id : fillingOn)
+		id = -1;
+	for (MyElevator &elevator : sim.elevators)
+	{
+		if (elevator.side == side && elevator.state == EState::FILLING && fillingOn[elevator.getFloor()] == -1)
+		{
+			fillingOn[elevator.getFloor()] = elevator.id;
+			anyFilling = true;
+		}
+	}
+
+	if (!anyFilling)
+		return;
+
+	int boarding[8] = {}; // by elevator id
+	for (std::pair<const int, MyPassenger> &passengerEntry : sim.passengers)
+	{
+		MyPassenger &passenger = passengerEntry.second;
+		if (passenger.state == PState::MOVING_TO_ELEVATOR)
+		{
+			++boarding[passenger.elevator];
+		}
+		else if ((passenger.state == PState::WAITING_FOR_ELEVATOR || passenger.state == PState::RETURNING) && passenger.elevator == -1)
+		{
+			int id = fillingOn[passenger.getFloor()];
+			if (id != -1)
+				passenger.set_elevator.insert(id);
+		}
+	}
+
+	for (MyElevator &elevator : sim.elevators)
+	{
+		if (elevator.side != side || elevator.state != EState::FILLING || elevator.time_on_the_floor_with_opened_doors < MIN_FILLING_TICS)
+			continue;
+		if (boarding[elevator.id])
+			continue;
+
+		int floor = elevator.getFloor();
+		int next = SWEEP_NEXT_FLOOR[up[elevator.ind]][floor];
+		up[elevator.ind] = next > floor;
+		elevator.go_to_floor = next;
+	}
+}
+
+HEADER_OLNY_INLINE MirrorOpponent::MirrorOpponent(Side side, const StrategyParams &params) : side(side)
+{
+	for (int i = 0; i < 4; ++i)
+	{
+		strategies[i].side = side;
+		strategies[i].doPredictions = false;
+		strategies[i].params = params;
+		strategies[i].firstMoveMinDest = params.firstMoveMinDest[i];
+	}
+}
+
+HEADER_OLNY_INLINE void MirrorOpponent::makeMove(Simulator &sim)
+{
+	for (MyElevator &elevator : sim.elevators)
+	{
+		if (elevator.side == side)
+			strategies[elevator.ind].makeMove(sim, elevator, nullptr);
+	}
+}
@@ -0,0 +1,59 @@
+#ifndef OPPONENT_MODEL_HPP
+#define OPPONENT_MODEL_HPP
+
+#ifndef HEADER_OLNY_INLINE
+#include "mystrategy.hpp"
+#endif
+
+#include <cstdint>
+#include <memory>
+
+const char * getOpponentModelName(OpponentModelType type);
+// OpponentModelType::COUNT for unknown names
+OpponentModelType getOpponentModelType(const char *name);
+
+// Per-tick cost of the model relative to a rollout tick of our own policy
+// plus Simulator::step (bench kernel rollout_tick), used to price rollouts
+double getOpponentModelCost(OpponentModelType type);
+
+// Enemy policy inside planner rollouts, one instance per rollout
+class OpponentModel
+{
+public:
+	virtual ~OpponentModel() {}
+
+	// Sets the commands of the enemy side, called before every rollout step
+	virtual void makeMove(Simulator &sim) = 0;
+};
+
+// nullptr for IDLE: enemy elevators get no commands
+std::unique_ptr<OpponentModel> createOpponentModel(OpponentModelType type, Side side, const StrategyParams &params);
+
+// Takes every waiting passenger on its floor and goes one floor on in its
+// direction after MIN_FILLING_TICS, turning at the ends
+class SweeperOpponent : public OpponentModel
+{
+public:
+	explicit SweeperOpponent(Side side);
+
+	void makeMove(Simulator &sim) override;
+
+private:
+	Side side;
+	bool up[4]; // by elevator ind
+};
+
+// Our own ElevatorStrategyUpDown playing the enemy side, without predictions
+class MirrorOpponent : public OpponentModel
+{
+public:
+	MirrorOpponent(Side side, const StrategyParams &params);
+
+	void makeMove(Simulator &sim) override;
+
+private:
+	Side side;
+	ElevatorStrategyUpDown strategies[4];
+};
+
+#endif
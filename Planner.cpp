@@ -0,0 +1,901 @@
+#ifndef HEADER_OLNY_INLINE
+#include "Planner.hpp"
+#include "OpponentModel.hpp"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+
+#ifndef HEADER_OLNY_INLINE
+#define HEADER_OLNY_INLINE
+#define HEADER_OLNY_STATIC
+#endif
+
+HEADER_OLNY_INLINE PlannerHandle::PlannerHandle()
+{
+}
+
+HEADER_OLNY_INLINE PlannerHandle::PlannerHandle(const PlannerHandle &)
+{
+}
+
+HEADER_OLNY_INLINE PlannerHandle::~PlannerHandle()
+{
+}
+
+HEADER_OLNY_INLINE SpeculativePlanner::~SpeculativePlanner()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		quit = true;
+	}
+	wakeUp.notify_all();
+	if (worker.joinable())
+		worker.join();
+}
+
+HEADER_OLNY_INLINE SpeculativePlanner::Job &SpeculativePlanner::getJob(int elevatorId)
+{
+	if (elevatorId >= (int) jobs.size())
+		jobs.resize(elevatorId + 1);
+	return jobs[elevatorId];
+}
+
+HEADER_OLNY_INLINE void SpeculativePlanner::speculate(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+{
+	int closingStart = sim.tick - elevator.closing_or_opening_ticks;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		Job &job = getJob(elevator.id);
+		if (job.closingStart != closingStart)
+		{
+			job.closingStart = closingStart;
+			++job.generation;
+			job.pending.reset();
+			job.completeFloor = -1;
+			job.partialFloor = -1;
+		}
+		else if (job.pending)
+		{
+			return;
+		}
+	}
+
+	// Only the calling thread changes jobs, so the job is still the same after the copy
+	std::unique_ptr<MyStrategy> snapshot(new MyStrategy(*strategy));
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		getJob(elevator.id).pending = std::move(snapshot);
+		++stats.snapshots;
+		if (!worker.joinable())
+			worker = std::thread(&SpeculativePlanner::run, this);
+	}
+	wakeUp.notify_one();
+}
+
+HEADER_OLNY_INLINE void SpeculativePlanner::commit(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+{
+	int closingStart = sim.tick - elevator.closing_or_opening_ticks;
+	int floor = -1;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		Job &job = getJob(elevator.id);
+		if (job.closingStart == closingStart)
+		{
+			if (job.completeFloor != -1)
+			{
+				floor = job.completeFloor;
+				++stats.complete;
+			}
+			else if (job.partialFloor != -1)
+			{
+				floor = job.partialFloor;
+				++stats.partial;
+			}
+		}
+
+		job.closingStart = -1;
+		++job.generation;
+		job.pending.reset();
+		if (floor == -1)
+			++stats.sync;
+	}
+
+	if (floor != -1)
+		elevator.go_to_floor = floor;
+	else
+		strategy->getElevatorStrategy(elevator.ind).recalcDestinationBeforeDoorsClose(sim, elevator, strategy);
+}
+
+HEADER_OLNY_INLINE void SpeculativePlanner::run()
+{
+	size_t next = 0;
+	std::unique_lock<std::mutex> lock(mutex);
+	while (!quit)
+	{
+		// Round robin over the elevators with a snapshot waiting
+		int id = -1;
+		for (size_t k = 0; k < jobs.size() && id == -1; ++k)
+		{
+			size_t i = (next + k) % jobs.size();
+			if (jobs[i].pending)
+				id = i;
+		}
+
+		if (id == -1)
+		{
+			wakeUp.wait(lock);
+			continue;
+		}
+
+		next = id + 1;
+		Job &job = jobs[id];
+		std::unique_ptr<MyStrategy> snapshot = std::move(job.pending);
+		int generation = job.generation;
+		job.partialFloor = -1;
+
+		MyElevator &elevator = snapshot->sim.elevators[id];
+		ElevatorStrategyUpDown &elevatorStrategy = snapshot->getElevatorStrategy(elevator.ind);
+		int delay = 98 - elevator.closing_or_opening_ticks;
+		bool finished = true;
+		for (int i = 0; i < LEVELS_COUNT; ++i)
+		{
+			if (i == elevator.getFloor())
+				continue;
+
+			lock.unlock();
+			int points = elevatorStrategy.evaluateDestination(snapshot->sim, elevator, snapshot.get(), i, delay);
+			lock.lock();
+
+			// jobs may have grown, but only for new elevator ids
+			Job &current = jobs[id];
+			if (quit || current.generation != generation)
+			{
+				finished = false;
+				break;
+			}
+
+			if (current.partialFloor == -1 || points > current.partialPoints)
+			{
+				current.partialFloor = i;
+				current.partialPoints = points;
+			}
+		}
+
+		if (finished)
+		{
+			++stats.passes;
+			jobs[id].completeFloor = jobs[id].partialFloor;
+			jobs[id].partialFloor = -1;
+		}
+	}
+}
+
+HEADER_OLNY_INLINE SpeculativePlanner::Stats SpeculativePlanner::getStats() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return stats;
+}
+
+HEADER_OLNY_INLINE void SpeculativePlanner::dump(std::ostream &out) const
+{
+	Stats s = getStats();
+	out << "PLANNER commits complete " << s.complete << " partial " << s.partial << " sync " << s.sync
+		<< " snapshots " << s.snapshots << " passes " << s.passes << std::endl;
+}
+
+HEADER_OLNY_INLINE SlicedPlanner::Job &SlicedPlanner::getJob(int elevatorId)
+{
+	if (elevatorId >= (int) jobs.size())
+		jobs.resize(elevatorId + 1);
+	return jobs[elevatorId];
+}
+
+HEADER_OLNY_INLINE int SlicedPlanner::advance(Job &job, Simulator &sim, MyElevator &elevator, MyStrategy *strategy, int budget)
+{
+	ElevatorStrategyUpDown &elevatorStrategy = strategy->getElevatorStrategy(elevator.ind);
+	int used = 0;
+	while (used < budget)
+	{
+		if (!job.rollouts.empty() && !job.rollouts.back()->isDone())
+		{
+			used += job.rollouts.back()->advance(budget - used);
+			continue;
+		}
+
+		if (job.nextFloor == elevator.getFloor())
+			++job.nextFloor;
+		if (job.nextFloor >= LEVELS_COUNT || budget - used < ROLLOUT_START_TICKS)
+			break;
+
+		job.rollouts.emplace_back(new DestinationRollout(*strategy));
+		elevatorStrategy.startRollout(*job.rollouts.back(), sim, elevator, job.nextFloor, 98 - elevator.closing_or_opening_ticks);
+		++job.nextFloor;
+		used += ROLLOUT_START_TICKS;
+	}
+
+	return used;
+}
+
+HEADER_OLNY_INLINE int64_t SlicedPlanner::getRemainingTicks(const Job &job, Simulator &sim, MyElevator &elevator, MyStrategy *strategy) const
+{
+	int64_t ticks = 0;
+	for (const std::unique_ptr<DestinationRollout> &rollout : job.rollouts)
+		ticks += rollout->length - rollout->tick;
+
+	int length = strategy->getElevatorStrategy(elevator.ind).getRolloutLength(sim, elevator, 98 - elevator.closing_or_opening_ticks);
+	for (int floor = job.nextFloor; floor < LEVELS_COUNT; ++floor)
+	{
+		if (floor != elevator.getFloor())
+			ticks += length;
+	}
+
+	return ticks;
+}
+
+HEADER_OLNY_INLINE int SlicedPlanner::getSimulatedTicksPerTick(const MyStrategy *strategy) const
+{
+	return (int) (ticksPerTick / (1.0 + getOpponentModelCost(strategy->rolloutOpponent)));
+}
+
+HEADER_OLNY_INLINE void SlicedPlanner::resetBudget(Simulator &sim, const MyStrategy *strategy)
+{
+	if (budgetTick != sim.tick)
+	{
+		budgetTick = sim.tick;
+		budgetLeft = getSimulatedTicksPerTick(strategy);
+	}
+}
+
+HEADER_OLNY_INLINE void SlicedPlanner::speculate(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+{
+	int closingStart = sim.tick - elevator.closing_or_opening_ticks;
+	Job &job = getJob(elevator.id);
+	if (job.closingStart != closingStart)
+	{
+		job.closingStart = closingStart;
+		job.nextFloor = 0;
+		job.rollouts.clear();
+	}
+
+	resetBudget(sim, strategy);
+
+	// Equal shares of the tick budget for the elevators closing now
+	int active = 0;
+	for (const Job &j : jobs)
+		active += j.closingStart != -1;
+	int share = std::max(1, getSimulatedTicksPerTick(strategy) / active);
+
+	// Rollouts started later see a fresher state, so wait while the rest
+	// fits twice into the ticks before 98, in case more elevators start closing
+	int ticksLeft = 98 - elevator.closing_or_opening_ticks;
+	if (2 * getRemainingTicks(job, sim, elevator, strategy) < (int64_t) (ticksLeft - 1) * share)
+		return;
+
+	int budget = std::min(budgetLeft, share);
+
+	int used = advance(job, sim, elevator, strategy, budget);
+	budgetLeft -= used;
+	stats.slicedTicks += used;
+}
+
+HEADER_OLNY_INLINE void SlicedPlanner::commit(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+{
+	int closingStart = sim.tick - elevator.closing_or_opening_ticks;
+	Job &job = getJob(elevator.id);
+	if (job.closingStart != closingStart)
+	{
+		job.nextFloor = 0;
+		job.rollouts.clear();
+	}
+
+	resetBudget(sim, strategy);
+	int used = advance(job, sim, elevator, strategy, budgetLeft);
+	budgetLeft -= used;
+
+	// Out of budget: the rest is finished anyway, so every floor is compared
+	// on a full rollout as in recalcDestinationBeforeDoorsClose
+	if (getRemainingTicks(job, sim, elevator, strategy) > 0)
+	{
+		int over = advance(job, sim, elevator, strategy, INT_MAX);
+		++stats.overBudgetCommits;
+		stats.overBudgetTicks += over;
+		used += over;
+	}
+
+	++stats.commits;
+	stats.commitTicks += used;
+	stats.maxCommitTicks = std::max(stats.maxCommitTicks, used);
+	if (used)
+		++stats.finishedOnCommit;
+
+	ElevatorStrategyUpDown &elevatorStrategy = strategy->getElevatorStrategy(elevator.ind);
+	int res = -100000;
+	int targetFloor = -1;
+	for (std::unique_ptr<DestinationRollout> &rollout : job.rollouts)
+	{
+		int points = elevatorStrategy.scoreRollout(*rollout, sim, elevator);
+		if (points > res)
+		{
+			res = points;
+			targetFloor = rollout->floor;
+		}
+	}
+
+	if (targetFloor != -1)
+		elevator.go_to_floor = targetFloor;
+
+	job.closingStart = -1;
+	job.rollouts.clear();
+}
+
+HEADER_OLNY_INLINE void SlicedPlanner::dump(std::ostream &out) const
+{
+	out << "PLANNER sliced " << ticksPerTick << " ticks per tick, commits " << stats.commits
+		<< " finished on commit " << stats.finishedOnCommit << " over budget " << stats.overBudgetCommits
+		<< " (" << stats.overBudgetTicks << " ticks) sliced ticks " << stats.slicedTicks
+		<< " commit ticks " << stats.commitTicks << " max " << stats.maxCommitTicks << std::endl;
+}
+
+HEADER_OLNY_INLINE void JointPlanner::commit(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+{
+	if ((int) decisions.size() < (int) sim.elevators.size())
+		decisions.resize(sim.elevators.size());
+
+	++stats.commits;
+	Decision &decision = decisions[elevator.id];
+	int closingStart = sim.tick - elevator.closing_or_opening_ticks;
+	if (decision.closingStart == closingStart)
+	{
+		++stats.grouped;
+		elevator.go_to_floor = decision.floor;
+		return;
+	}
+
+	std::vector<MyElevator*> group = {&elevator};
+	for (MyElevator &e : sim.elevators)
+	{
+		if (e.id != elevator.id && e.side == elevator.side && e.state == EState::CLOSING
+			&& e.closing_or_opening_ticks <= 98 && e.closing_or_opening_ticks >= 98 - WINDOW
+			&& decisions[e.id].closingStart != sim.tick - e.closing_or_opening_ticks)
+		{
+			group.push_back(&e);
+		}
+	}
+
+	if (group.size() == 1)
+	{
+		strategy->getElevatorStrategy(elevator.ind).recalcDestinationBeforeDoorsClose(sim, elevator, strategy);
+		decision.closingStart = closingStart;
+		decision.floor = elevator.go_to_floor;
+		return;
+	}
+
+	++stats.groups;
+	planGroup(sim, group, strategy);
+	elevator.go_to_floor = decision.floor;
+}
+
+HEADER_OLNY_INLINE void JointPlanner::planGroup(Simulator &sim, const std::vector<MyElevator*> &group, MyStrategy *strategy)
+{
+	MyStrategy base = *strategy;
+	base.strategy1.doPredictions = false;
+	base.strategy2.doPredictions = false;
+	base.strategy3.doPredictions = false;
+	base.strategy4.doPredictions = false;
+
+	// Candidates of every member by getDestinationBounds, as pruned by
+	// recalcDestinationBeforeDoorsClose; no rollouts of its own
+	std::vector<std::vector<int>> candidates(group.size());
+	std::vector<std::vector<int>> floors(group.size());
+	std::vector<int> best;
+	int length = 0;
+	float coef = 1.0f;
+	for (size_t m = 0; m < group.size(); ++m)
+	{
+		MyElevator &elevator = *group[m];
+		ElevatorStrategyUpDown &elevatorStrategy = strategy->getElevatorStrategy(elevator.ind);
+		int delay = 98 - elevator.closing_or_opening_ticks;
+		int horizon = elevatorStrategy.getRolloutLength(sim, elevator, delay);
+		length = std::max(length, horizon);
+		if (m == 0)
+			coef = elevatorStrategy.getRolloutCoef(sim, delay);
+
+		int bounds[LEVELS_COUNT];
+		elevatorStrategy.getDestinationBounds(sim, elevator, horizon, bounds);
+		for (int i = 0; i < LEVELS_COUNT; ++i)
+		{
+			if (i != elevator.getFloor())
+				candidates[m].push_back(i);
+		}
+		std::stable_sort(candidates[m].begin(), candidates[m].end(), [&bounds](int a, int b) { return bounds[a] > bounds[b]; });
+
+		int pruneBound = strategy->getParams().pruneBound;
+		while (candidates[m].size() > 1 && pruneBound >= 0 && bounds[candidates[m].back()] <= pruneBound)
+			candidates[m].pop_back();
+		floors[m].push_back(candidates[m][0]);
+	}
+
+	// More floors for the members in turn while the combinations fit
+	int combinations = 1;
+	for (bool grown = true; grown; )
+	{
+		grown = false;
+		for (size_t m = 0; m < group.size(); ++m)
+		{
+			size_t kept = floors[m].size();
+			if (kept < candidates[m].size() && combinations / kept * (kept + 1) <= MAX_COMBINATIONS)
+			{
+				combinations = combinations / kept * (kept + 1);
+				floors[m].push_back(candidates[m][kept]);
+				grown = true;
+			}
+		}
+	}
+
+	if (combinations == 1)
+	{
+		for (size_t m = 0; m < group.size(); ++m)
+			best.push_back(floors[m][0]);
+		setDecisions(sim, group, best);
+		return;
+	}
+
+	// Every combination of the kept floors, the longest horizon of the group
+	std::vector<size_t> index(group.size(), 0);
+	int bestPoints = 0;
+	while (true)
+	{
+		DestinationRollout rollout(base);
+		for (size_t m = 0; m < group.size(); ++m)
+			rollout.copy.sim.elevators[group[m]->id].go_to_floor = floors[m][index[m]];
+		rollout.length = length;
+		rollout.advance(rollout.length);
+		++stats.rollouts;
+
+		int points = strategy->getElevatorStrategy(group[0]->ind).getRolloutValue(rollout.copy, coef);
+		for (size_t m = 0; m < group.size(); ++m)
+			points += strategy->getElevatorStrategy(group[m]->ind).getFloorAdjustment(rollout.copy, sim, *group[m], floors[m][index[m]]);
+
+		if (best.empty() || points > bestPoints)
+		{
+			bestPoints = points;
+			best.clear();
+			for (size_t m = 0; m < group.size(); ++m)
+				best.push_back(floors[m][index[m]]);
+		}
+
+		size_t m = 0;
+		while (m < group.size() && ++index[m] == floors[m].size())
+			index[m++] = 0;
+		if (m == group.size())
+			break;
+	}
+
+	setDecisions(sim, group, best);
+}
+
+HEADER_OLNY_INLINE void JointPlanner::setDecisions(Simulator &sim, const std::vector<MyElevator*> &group, const std::vector<int> &floors)
+{
+	for (size_t m = 0; m < group.size(); ++m)
+	{
+		Decision &decision = decisions[group[m]->id];
+		decision.closingStart = sim.tick - group[m]->closing_or_opening_ticks;
+		decision.floor = floors[m];
+	}
+}
+
+HEADER_OLNY_INLINE void JointPlanner::dump(std::ostream &out) const
+{
+	out << "PLANNER joint commits " << stats.commits << " groups " << stats.groups << " from groups " << stats.grouped
+		<< " rollouts " << stats.rollouts << std::endl;
+}
+
+HEADER_OLNY_INLINE MctsPlanner::Tree &MctsPlanner::getTree(Simulator &sim, MyElevator &elevator)
+{
+	if (elevator.id >= (int) trees.size())
+		trees.resize(elevator.id + 1);
+
+	Tree &tree = trees[elevator.id];
+	int closingStart = sim.tick - elevator.closing_or_opening_ticks;
+	if (tree.closingStart != closingStart)
+	{
+		tree.closingStart = closingStart;
+		if (tree.root && tree.rootFloor == elevator.getFloor())
+		{
+			tree.nodes = decay(*tree.root, REUSE_DECAY);
+			tree.reused = true;
+		}
+		else
+		{
+			tree.root.reset(new Node());
+			tree.nodes = 1;
+			tree.reused = false;
+		}
+		tree.iteration.reset();
+		tree.rootFloor = -1;
+		tree.minValue = INT_MAX;
+		tree.maxValue = INT_MIN;
+	}
+	return tree;
+}
+
+HEADER_OLNY_INLINE int MctsPlanner::decay(Node &node, double weight)
+{
+	node.visits *= weight;
+	node.valueSum *= weight;
+	int count = 1;
+	for (std::unique_ptr<Node> &child : node.children)
+	{
+		if (child)
+			count += decay(*child, weight);
+	}
+	return count;
+}
+
+HEADER_OLNY_INLINE int MctsPlanner::selectFloor(const Tree &tree, const Node &node, int floor) const
+{
+	double range = tree.maxValue > tree.minValue ? tree.maxValue - tree.minValue : 1.0;
+	double logVisits = std::log(std::max(1.0, node.visits));
+	int best = -1;
+	double bestScore = 0;
+	for (int i = 0; i < LEVELS_COUNT; ++i)
+	{
+		if (i == floor)
+			continue;
+
+		const Node *child = node.children[i].get();
+		if (!child || child->visits <= 0)
+			return i;
+
+		double score = (child->valueSum / child->visits - tree.minValue) / range + EXPLORATION * std::sqrt(logVisits / child->visits);
+		if (best == -1 || score > bestScore)
+		{
+			best = i;
+			bestScore = score;
+		}
+	}
+	return best;
+}
+
+HEADER_OLNY_INLINE bool MctsPlanner::descend(Tree &tree, Iteration &iteration, int floor, int elevatorId)
+{
+	Node *node = iteration.path.back();
+	std::unique_ptr<Node> &child = node->children[floor];
+	bool known = child != nullptr;
+	if (!known)
+	{
+		if (tree.nodes >= MAX_NODES && node != tree.root.get())
+			return false;
+		child.reset(new Node());
+		++tree.nodes;
+	}
+
+	iteration.rollout.copy.sim.elevators[elevatorId].go_to_floor = floor;
+	iteration.path.push_back(child.get());
+	return known;
+}
+
+HEADER_OLNY_INLINE bool MctsPlanner::iterate(Tree &tree, Simulator &sim, MyElevator &elevator, MyStrategy *strategy, Clock::time_point deadline)
+{
+	ElevatorStrategyUpDown &elevatorStrategy = strategy->getElevatorStrategy(elevator.ind);
+	if (!tree.iteration)
+	{
+		tree.iteration.reset(new Iteration(*strategy));
+		Iteration &iteration = *tree.iteration;
+		int delay = 98 - elevator.closing_or_opening_ticks;
+		int floor = selectFloor(tree, *tree.root, elevator.getFloor());
+		elevatorStrategy.startRollout(iteration.rollout, sim, elevator, floor, delay);
+		iteration.rollout.length = std::min(delay + HORIZON_DECISIONS * (iteration.rollout.length - delay), 7200 - sim.tick - 2);
+		iteration.firstFloor = floor;
+		iteration.path.push_back(tree.root.get());
+		iteration.descending = descend(tree, iteration, floor, elevator.id);
+	}
+
+	// Known nodes choose the floor on the next closings of the elevator, the
+	// heuristic plays the rest
+	Iteration &iteration = *tree.iteration;
+	DestinationRollout &rollout = iteration.rollout;
+	MyElevator &copyElevator = rollout.copy.sim.elevators[elevator.id];
+	int decisionTick = tree.closingStart + 98;
+	while (!rollout.isDone())
+	{
+		if (rollout.tick % 16 == 0 && Clock::now() >= deadline)
+			return false;
+
+		rollout.advance(1);
+		++stats.ticks;
+		if (iteration.descending && copyElevator.state == EState::CLOSING && copyElevator.closing_or_opening_ticks == 98
+			&& rollout.copy.sim.tick > decisionTick)
+		{
+			int floor = selectFloor(tree, *iteration.path.back(), copyElevator.getFloor());
+			iteration.descending = descend(tree, iteration, floor, elevator.id);
+		}
+	}
+
+	int value = elevatorStrategy.getRolloutValue(rollout.copy, rollout.coef)
+		+ elevatorStrategy.getFloorAdjustment(rollout.copy, sim, elevator, iteration.firstFloor);
+	tree.minValue = std::min(tree.minValue, value);
+	tree.maxValue = std::max(tree.maxValue, value);
+	for (Node *node : iteration.path)
+	{
+		node->visits += 1;
+		node->valueSum += value;
+	}
+
+	++stats.iterations;
+	stats.maxDepth = std::max(stats.maxDepth, (int) iteration.path.size() - 1);
+	tree.iteration.reset();
+	return true;
+}
+
+HEADER_OLNY_INLINE void MctsPlanner::speculate(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+{
+	Tree &tree = getTree(sim, elevator);
+	Clock::time_point end = getTickDeadline();
+	while (Clock::now() < end && iterate(tree, sim, elevator, strategy, end))
+	{
+	}
+}
+
+HEADER_OLNY_INLINE void MctsPlanner::commit(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+{
+	Tree &tree = getTree(sim, elevator);
+	++stats.commits;
+	if (tree.reused)
+		++stats.reused;
+
+	// Untried floors get iterations within the budget of this tick too
+	int floor = elevator.getFloor();
+	Clock::time_point end = getTickDeadline();
+	while (true)
+	{
+		bool untried = false;
+		for (int i = 0; i < LEVELS_COUNT; ++i)
+		{
+			const Node *child = tree.root->children[i].get();
+			untried |= i != floor && (!child || child->visits <= 0);
+		}
+		if (!untried && !tree.iteration)
+			break;
+		if (Clock::now() >= end || !iterate(tree, sim, elevator, strategy, end))
+		{
+			++stats.expired;
+			break;
+		}
+		++stats.commitIterations;
+	}
+
+	// Best mean of the visited floors rather than most visits, as
+	// recalcDestinationBeforeDoorsClose
+	int targetFloor = -1;
+	double res = 0;
+	for (int i = 0; i < LEVELS_COUNT; ++i)
+	{
+		const Node *child = tree.root->children[i].get();
+		if (i == floor || !child || child->visits <= 0)
+			continue;
+
+		double mean = child->valueSum / child->visits;
+		if (targetFloor == -1 || mean > res)
+		{
+			res = mean;
+			targetFloor = i;
+		}
+	}
+
+	tree.iteration.reset();
+	tree.closingStart = -1;
+	if (targetFloor == -1)
+	{
+		++stats.fallbacks;
+		strategy->getElevatorStrategy(elevator.ind).recalcDestinationBeforeDoorsClose(sim, elevator, strategy);
+		tree.root.reset();
+		tree.rootFloor = -1;
+		return;
+	}
+
+	elevator.go_to_floor = targetFloor;
+	std::unique_ptr<Node> next = std::move(tree.root->children[targetFloor]);
+	tree.root = std::move(next);
+	tree.rootFloor = targetFloor;
+}
+
+HEADER_OLNY_INLINE MctsPlanner::Clock::time_point MctsPlanner::getTickDeadline() const
+{
+	int active = 0;
+	for (const Tree &t : trees)
+		active += t.closingStart != -1;
+	return Clock::now() + std::chrono::microseconds(tickBudgetUs / std::max(1, active));
+}
+
+HEADER_OLNY_INLINE void MctsPlanner::dump(std::ostream &out) const
+{
+	out << "PLANNER mcts " << tickBudgetUs << " us per tick, commits " << stats.commits << " reused " << stats.reused
+		<< " iterations " << stats.iterations << " on commit " << stats.commitIterations
+		<< " expired " << stats.expired << " fallbacks " << stats.fallbacks
+		<< " simulated ticks " << stats.ticks << " max depth " << stats.maxDepth << std::endl;
+}
+
+HEADER_OLNY_INLINE BeamPlanner::Plan BeamPlanner::startPlan(Simulator &sim, MyElevator &elevator) const
+{
+	Plan plan;
+	plan.floor = elevator.getFloor();
+	plan.visited = 1 << plan.floor;
+	for (float &mass : plan.cargoMass)
+		mass = 1.0f;
+
+	for (int id : elevator.passengers)
+	{
+		MyPassenger &passenger = sim.passengers[id];
+		plan.cargoPoints[passenger.dest_floor] += passenger.getValue(elevator.side);
+		++plan.cargoCount[passenger.dest_floor];
+		plan.cargoMass[passenger.dest_floor] *= passenger.mass;
+		plan.mass *= passenger.mass;
+		++plan.passengers;
+	}
+	return plan;
+}
+
+HEADER_OLNY_INLINE BeamPlanner::Plan BeamPlanner::extendPlan(const Plan &plan, int floor, int ticksLeft, Side side, const std::vector<Waiting> *waiting) const
+{
+	Plan next = plan;
+	next.stops[next.count++] = floor;
+	next.floor = floor;
+	next.ticks += MyElevator::calcTimeToFloor(plan.floor, floor, plan.passengers, plan.mass);
+
+	double arrival = next.ticks + 100;
+	if (arrival < ticksLeft)
+		next.points += next.cargoPoints[floor];
+	next.passengers -= next.cargoCount[floor];
+	next.mass /= next.cargoMass[floor];
+	next.cargoPoints[floor] = 0;
+	next.cargoCount[floor] = 0;
+	next.cargoMass[floor] = 1.0f;
+
+	if (!(next.visited & (1 << floor)))
+	{
+		next.visited |= 1 << floor;
+		for (const Waiting &passenger : waiting[floor])
+		{
+			if (next.passengers >= MAX_PASSENGERS)
+				break;
+			if (passenger.appear > arrival + MIN_FILLING_TICS || passenger.leave < arrival)
+				continue;
+
+			next.cargoPoints[passenger.dest] += PICKUP_WEIGHT * passenger.value;
+			++next.cargoCount[passenger.dest];
+			next.cargoMass[passenger.dest] *= passenger.mass;
+			next.mass *= passenger.mass;
+			++next.passengers;
+		}
+	}
+
+	next.ticks += DOOR_TICKS;
+	double cargo = 0;
+	if (next.ticks < ticksLeft)
+	{
+		for (double points : next.cargoPoints)
+			cargo += points;
+	}
+	next.score = (next.points + CARGO_WEIGHT * cargo) / next.ticks;
+	return next;
+}
+
+HEADER_OLNY_INLINE int BeamPlanner::simulatePlan(Simulator &sim, MyElevator &elevator, MyStrategy *strategy, const Plan &plan)
+{
+	ElevatorStrategyUpDown &elevatorStrategy = strategy->getElevatorStrategy(elevator.ind);
+	DestinationRollout rollout(*strategy);
+	elevatorStrategy.startRollout(rollout, sim, elevator, plan.stops[0], 0);
+	rollout.length = std::min(HORIZON_ROLLOUTS * rollout.length, 7200 - sim.tick - 2);
+
+	// The next stop is set on the closing tick 98 of each stop, as commit does
+	MyElevator &copyElevator = rollout.copy.sim.elevators[elevator.id];
+	int stop = 1;
+	while (!rollout.isDone() && stop < plan.count)
+	{
+		rollout.advance(1);
+		if (copyElevator.state == EState::CLOSING && copyElevator.closing_or_opening_ticks == 98)
+			copyElevator.go_to_floor = plan.stops[stop++];
+	}
+	rollout.advance(rollout.length);
+	++stats.rollouts;
+
+	return elevatorStrategy.scoreRollout(rollout, sim, elevator);
+}
+
+HEADER_OLNY_INLINE void BeamPlanner::commit(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+{
+	++stats.commits;
+	int ticksLeft = 7200 - sim.tick - 2;
+
+	std::vector<Waiting> waiting[LEVELS_COUNT];
+	for (std::pair<const int, MyPassenger> &passengerEntry : sim.passengers)
+	{
+		MyPassenger &passenger = passengerEntry.second;
+		if ((passenger.state == PState::WAITING_FOR_ELEVATOR || passenger.state == PState::RETURNING)
+			&& std::abs(passenger.dest_floor - passenger.from_floor) > 1)
+		{
+			waiting[passenger.getFloor()].push_back({passenger.dest_floor, passenger.getValue(elevator.side), 0, passenger.time_to_away, passenger.mass});
+		}
+	}
+
+	// Passengers to come out on the floors, their next destination as Simulator predicts it
+	int horizon = STOPS * (DOOR_TICKS + LEVELS_COUNT * 60);
+	for (auto && p = sim.outPassengers.begin(); p != sim.outPassengers.upper_bound(sim.tick + horizon); ++p)
+	{
+		MyPassenger &passenger = p->second;
+		int floor = passenger.getFloor();
+		int dest = passenger.getNextDestFloor();
+		if (std::abs(dest - floor) <= 1)
+			continue;
+
+		int value = std::abs(dest - floor) * 10;
+		if (passenger.side != elevator.side)
+			value *= 2;
+		int appear = p->first - sim.tick;
+		waiting[floor].push_back({dest, value, appear, appear + 500, passenger.mass});
+	}
+	for (std::vector<Waiting> &w : waiting)
+		std::stable_sort(w.begin(), w.end(), [](const Waiting &a, const Waiting &b) { return a.value > b.value; });
+
+	std::vector<Plan> beam = {startPlan(sim, elevator)};
+	std::vector<Plan> next;
+	for (int s = 0; s < STOPS; ++s)
+	{
+		next.clear();
+		for (const Plan &plan : beam)
+		{
+			for (int floor = 0; floor < LEVELS_COUNT; ++floor)
+			{
+				if (floor != plan.floor)
+					next.push_back(extendPlan(plan, floor, ticksLeft, elevator.side, waiting));
+			}
+		}
+		stats.plans += next.size();
+
+		std::stable_sort(next.begin(), next.end(), [](const Plan &a, const Plan &b) { return a.score > b.score; });
+		if ((int) next.size() > BEAM_WIDTH)
+			next.resize(BEAM_WIDTH);
+		beam.swap(next);
+	}
+
+	// The best plan of each first floor, in the order of the beam
+	std::vector<const Plan*> top;
+	for (const Plan &plan : beam)
+	{
+		bool known = false;
+		for (const Plan *other : top)
+			known |= other->stops[0] == plan.stops[0];
+		if (!known && (int) top.size() < TOP_K)
+			top.push_back(&plan);
+	}
+
+	if (top.size() == 1)
+	{
+		++stats.single;
+		elevator.go_to_floor = top[0]->stops[0];
+		return;
+	}
+
+	int res = -100000;
+	int targetFloor = -1;
+	for (const Plan *plan : top)
+	{
+		int points = simulatePlan(sim, elevator, strategy, *plan);
+		if (points > res)
+		{
+			res = points;
+			targetFloor = plan->stops[0];
+		}
+	}
+	elevator.go_to_floor = targetFloor;
+}
+
+HEADER_OLNY_INLINE void BeamPlanner::dump(std::ostream &out) const
+{
+	out << "PLANNER beam commits " << stats.commits << " single " << stats.single
+		<< " plans " << stats.plans << " rollouts " << stats.rollouts << std::endl;
+}
@@ -0,0 +1,332 @@
+#ifndef PLANNER_HPP
+#define PLANNER_HPP
+
+#ifndef HEADER_OLNY_INLINE
+#include "mystrategy.hpp"
+#endif
+
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+// Chooses go_to_floor of a closing elevator in place of the synchronous
+// recalcDestinationBeforeDoorsClose: speculate() is called on CLOSING ticks
+// before 98, commit() on tick 98 must set the destination
+class ClosingPlanner
+{
+public:
+	virtual ~ClosingPlanner() {}
+
+	virtual void speculate(Simulator &sim, MyElevator &elevator, MyStrategy *strategy) = 0;
+	virtual void commit(Simulator &sim, MyElevator &elevator, MyStrategy *strategy) = 0;
+	virtual void dump(std::ostream &out) const = 0;
+};
+
+// Runs the closing-time destination search of recalcDestinationBeforeDoorsClose
+// on a worker thread. Every CLOSING tick before 98 hands the worker a fresh
+// snapshot of the strategy once it has taken the previous one, a pass over
+// the candidate floors always finishes on the snapshot it started with.
+// Tick 98 takes the last finished pass, else the best floor of the pass in
+// progress, else runs the search synchronously.
+class SpeculativePlanner : public ClosingPlanner
+{
+public:
+	struct Stats
+	{
+		int complete = 0;   // commits of a finished pass
+		int partial = 0;    // commits of the best candidate so far
+		int sync = 0;       // nothing evaluated yet, searched on tick 98
+		int snapshots = 0;
+		int passes = 0;     // finished passes, including outdated ones
+	};
+
+	SpeculativePlanner() {}
+	~SpeculativePlanner();
+
+	void speculate(Simulator &sim, MyElevator &elevator, MyStrategy *strategy) override;
+	void commit(Simulator &sim, MyElevator &elevator, MyStrategy *strategy) override;
+
+	Stats getStats() const;
+	void dump(std::ostream &out) const override;
+
+private:
+	struct Job
+	{
+		int closingStart = -1;   // tick the doors started closing, -1 - no job
+		int generation = 0;      // changes when the job is committed or restarted
+		std::unique_ptr<MyStrategy> pending; // newest snapshot, not taken by the worker yet
+		int completeFloor = -1;  // best floor of the last finished pass
+		int partialFloor = -1;   // best floor of the pass in progress
+		int partialPoints = 0;
+	};
+
+	void run();
+	Job &getJob(int elevatorId);
+
+	mutable std::mutex mutex;
+	std::condition_variable wakeUp;
+	std::vector<Job> jobs; // by MyElevator id
+	Stats stats;
+	bool quit = false;
+	std::thread worker;
+};
+
+// Single-threaded version: the candidate rollouts are advanced by at most
+// ticksPerTick simulated ticks per real tick, shared by all closing elevators,
+// and start as late as that allows. Later starts see a fresher state: 96 ticks
+// per tick (rollouts from ~tick 20) lost 6% score to MyStrategy, 400 - under 1%.
+// Tick 98 finishes the rollouts within the same budget. Floors still not
+// simulated are finished past it, counted in stats, so the choice is always
+// over full rollouts of every floor.
+class SlicedPlanner : public ClosingPlanner
+{
+public:
+	static constexpr int DEFAULT_TICKS_PER_TICK = 400;
+	// Copying MyStrategy for a rollout costs ~3 idle rollout ticks (bench mid-game)
+	static constexpr int ROLLOUT_START_TICKS = 3;
+
+	struct Stats
+	{
+		int commits = 0;
+		int finishedOnCommit = 0;   // commits that had to simulate on tick 98
+		int overBudgetCommits = 0;  // commits that finished floors past the budget
+		int64_t overBudgetTicks = 0;
+		int64_t slicedTicks = 0;    // simulated before tick 98
+		int64_t commitTicks = 0;    // simulated on tick 98
+		int maxCommitTicks = 0;
+	};
+
+	int ticksPerTick = DEFAULT_TICKS_PER_TICK;
+
+	void speculate(Simulator &sim, MyElevator &elevator, MyStrategy *strategy) override;
+	void commit(Simulator &sim, MyElevator &elevator, MyStrategy *strategy) override;
+
+	const Stats &getStats() const { return stats; }
+	void dump(std::ostream &out) const override;
+
+private:
+	struct Job
+	{
+		int closingStart = -1;   // tick the doors started closing, -1 - no job
+		int nextFloor = 0;       // next candidate to start
+		std::vector<std::unique_ptr<DestinationRollout>> rollouts;
+	};
+
+	Job &getJob(int elevatorId);
+	// Starts and advances the rollouts of job within budget, returns simulated
+	// ticks with ROLLOUT_START_TICKS per started rollout
+	int advance(Job &job, Simulator &sim, MyElevator &elevator, MyStrategy *strategy, int budget);
+	// ticksPerTick is priced for the idle enemy, slower rollout opponents get fewer
+	int getSimulatedTicksPerTick(const MyStrategy *strategy) const;
+	void resetBudget(Simulator &sim, const MyStrategy *strategy);
+	// Simulated ticks the job still needs if the rest is started now
+	int64_t getRemainingTicks(const Job &job, Simulator &sim, MyElevator &elevator, MyStrategy *strategy) const;
+
+	std::vector<Job> jobs; // by MyElevator id
+	int budgetTick = -1;
+	int budgetLeft = 0;
+	Stats stats;
+};
+
+// Our elevators that are to commit within WINDOW closing ticks of each
+// other are planned as a group on the first commit: the candidate floors of
+// every member are ranked by getDestinationBounds, the best ones are kept in
+// turn while the combinations fit into MAX_COMBINATIONS, and only the
+// combinations are simulated, each rollout from one shared copy of the
+// strategy moving all members. The others take their floor from the group
+// on their tick 98. A lone elevator plans as recalcDestinationBeforeDoorsClose.
+class JointPlanner : public ClosingPlanner
+{
+public:
+	static constexpr int WINDOW = 20;
+	static constexpr int MAX_COMBINATIONS = 16;
+
+	struct Stats
+	{
+		int commits = 0;
+		int groups = 0;          // commits that planned more than one elevator
+		int grouped = 0;         // commits taken from an earlier group
+		int64_t rollouts = 0;    // in groups
+	};
+
+	void speculate(Simulator &, MyElevator &, MyStrategy *) override {}
+	void commit(Simulator &sim, MyElevator &elevator, MyStrategy *strategy) override;
+
+	const Stats &getStats() const { return stats; }
+	void dump(std::ostream &out) const override;
+
+private:
+	struct Decision
+	{
+		int closingStart = -1;
+		int floor = -1;
+	};
+
+	void planGroup(Simulator &sim, const std::vector<MyElevator*> &group, MyStrategy *strategy);
+	void setDecisions(Simulator &sim, const std::vector<MyElevator*> &group, const std::vector<int> &floors);
+
+	std::vector<Decision> decisions; // by MyElevator id
+	Stats stats;
+};
+
+// Monte Carlo tree search over the successive closing-time floors of each
+// elevator, UCB1 over the floors at every decision. The tree is open loop:
+// nodes keep statistics only and every iteration replays its path from a
+// copy of the current strategy, the other decisions follow the heuristic
+// up to HORIZON_DECISIONS rollout lengths. Iterations run for tickBudgetUs
+// on CLOSING ticks, tick 98 tries the untried floors within the same budget
+// and picks among the visited ones, recalcDestinationBeforeDoorsClose if none
+// was. The subtree of the chosen floor becomes the root of the next closing
+// there.
+class MctsPlanner : public ClosingPlanner
+{
+public:
+	static constexpr int DEFAULT_TICK_BUDGET_US = 4000;
+	static constexpr int HORIZON_DECISIONS = 2;
+	static constexpr int MAX_NODES = 4096;     // per elevator
+	static constexpr double EXPLORATION = 1.0; // UCB1 constant, values scaled to [0, 1]
+	static constexpr double REUSE_DECAY = 0.5; // weight of the statistics kept by re-rooting
+
+	struct Stats
+	{
+		int commits = 0;
+		int reused = 0;              // commits that started from a kept subtree
+		int64_t iterations = 0;
+		int64_t commitIterations = 0; // run on tick 98
+		int expired = 0;             // commits out of budget before the search was done
+		int fallbacks = 0;           // commits with no floor visited
+		int64_t ticks = 0;           // simulated
+		int maxDepth = 0;
+	};
+
+	int tickBudgetUs = DEFAULT_TICK_BUDGET_US; // shared by the elevators closing now
+
+	void speculate(Simulator &sim, MyElevator &elevator, MyStrategy *strategy) override;
+	void commit(Simulator &sim, MyElevator &elevator, MyStrategy *strategy) override;
+
+	const Stats &getStats() const { return stats; }
+	void dump(std::ostream &out) const override;
+
+private:
+	struct Node
+	{
+		double visits = 0;
+		double valueSum = 0;
+		std::unique_ptr<Node> children[LEVELS_COUNT]; // by floor
+	};
+
+	// Iteration in progress, continued on the next CLOSING tick when out of time
+	struct Iteration
+	{
+		DestinationRollout rollout;
+		std::vector<Node*> path;
+		int firstFloor = -1;
+		bool descending = true; // the path is still in the tree
+
+		explicit Iteration(const MyStrategy &strategy) : rollout(strategy) {}
+	};
+
+	struct Tree
+	{
+		int closingStart = -1;   // closing the root decides, -1 - no search
+		int rootFloor = -1;      // floor of the kept root, -1 - none
+		std::unique_ptr<Node> root;
+		std::unique_ptr<Iteration> iteration;
+		int nodes = 0;
+		bool reused = false;     // root was kept from the previous closing
+		int minValue = INT_MAX;  // range of the values seen, for UCB1 scaling
+		int maxValue = INT_MIN;
+	};
+
+	typedef std::chrono::steady_clock Clock;
+
+	Tree &getTree(Simulator &sim, MyElevator &elevator);
+	// End of the share of tickBudgetUs of each elevator closing now
+	Clock::time_point getTickDeadline() const;
+	// Selection, expansion, heuristic rollout and backpropagation, false if
+	// the deadline came first
+	bool iterate(Tree &tree, Simulator &sim, MyElevator &elevator, MyStrategy *strategy, Clock::time_point deadline);
+	// Adds floor to the path, false once the path leaves the tree
+	bool descend(Tree &tree, Iteration &iteration, int floor, int elevatorId);
+	int selectFloor(const Tree &tree, const Node &node, int floor) const;
+	// Scales the statistics of the subtree by weight, returns its node count
+	static int decay(Node &node, double weight);
+
+	std::vector<Tree> trees; // by MyElevator id
+	Stats stats;
+};
+
+// Plans the next STOPS floors of the closing elevator on tick 98: a beam
+// search scores the itineraries with an analytic model, the travel time of
+// MyElevator::calcTimeToFloor plus DOOR_TICKS a stop, deliveries of the
+// cargo and pickups of the passengers waiting on the floors. The best plan
+// of each of the TOP_K best first floors is simulated with the elevator
+// following it, the first floor of the best one is committed. The plan is
+// made anew on every closing.
+class BeamPlanner : public ClosingPlanner
+{
+public:
+	static constexpr int STOPS = 3;
+	static constexpr int BEAM_WIDTH = 16;
+	static constexpr int TOP_K = 3;
+	static constexpr int DOOR_TICKS = 100 + 100 + MIN_FILLING_TICS; // opening, closing, filling
+	static constexpr int HORIZON_ROLLOUTS = 1;    // simulated ticks in usual rollout lengths, 2 lost 3.6% to MyStrategy
+	static constexpr double PICKUP_WEIGHT = 0.5;  // share of the waiting passengers we get
+	static constexpr double CARGO_WEIGHT = 0.5;   // value of the cargo left at the end of the plan
+
+	struct Stats
+	{
+		int commits = 0;
+		int single = 0;          // one first floor left, committed without simulation
+		int64_t plans = 0;       // scored analytically
+		int64_t rollouts = 0;
+	};
+
+	void speculate(Simulator &, MyElevator &, MyStrategy *) override {}
+	void commit(Simulator &sim, MyElevator &elevator, MyStrategy *strategy) override;
+
+	const Stats &getStats() const { return stats; }
+	void dump(std::ostream &out) const override;
+
+private:
+	struct Plan
+	{
+		int stops[STOPS];
+		int count = 0;
+		int floor = 0;
+		double ticks = 0;        // since the doors close
+		double points = 0;       // delivered within the plan
+		double cargoPoints[LEVELS_COUNT] = {}; // on board by destination
+		int cargoCount[LEVELS_COUNT] = {};
+		float cargoMass[LEVELS_COUNT];        // product by destination
+		int passengers = 0;
+		float mass = 1.0f;
+		int visited = 0;         // bit mask of the floors already picked up from
+		double score = 0;
+	};
+
+	// Passenger on a floor, now or in appear ticks
+	struct Waiting
+	{
+		int dest;
+		int value;
+		int appear;
+		int leave;               // goes to the stairs
+		float mass;
+	};
+
+	Plan startPlan(Simulator &sim, MyElevator &elevator) const;
+	Plan extendPlan(const Plan &plan, int floor, int ticksLeft, Side side, const std::vector<Waiting> *waiting) const;
+	// Rollout score of the elevator following plan, then the heuristic
+	int simulatePlan(Simulator &sim, MyElevator &elevator, MyStrategy *strategy, const Plan &plan);
+
+	Stats stats;
+};
+
+#endif
@@ -0,0 +1,367 @@
+#include "Rating.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+static void hashInt(uint64_t &hash, int64_t value)
+{
+	for (int i = 0; i < 8; ++i)
+	{
+		hash ^= (uint8_t) (value >> (i * 8));
+		hash *= 1099511628211ull;
+	}
+}
+
+uint64_t getBuildHash(const std::string &binaryPath)
+{
+#ifdef _LINUX
+	std::ifstream in("/proc/self/exe", std::ios::binary);
+#else
+	std::ifstream in(binaryPath, std::ios::binary);
+#endif
+	if (!in)
+		return 0;
+
+	uint64_t hash = 14695981039346656037ull;
+	char buffer[65536];
+	while (in.read(buffer, sizeof(buffer)) || in.gcount() > 0)
+	{
+		for (std::streamsize i = 0; i < in.gcount(); ++i)
+		{
+			hash ^= (uint8_t) buffer[i];
+			hash *= 1099511628211ull;
+		}
+	}
+	return hash;
+}
+
+std::string getStrategyVersion(const StrategyRegistry &registry, const std::string &name, uint64_t buildHash)
+{
+	uint64_t hash = 14695981039346656037ull;
+	hashInt(hash, (int64_t) buildHash);
+	for (char c : registry.getInfo(name).config)
+		hashInt(hash, c);
+
+	std::ostringstream version;
+	version << name << "#" << std::hex << hash;
+	return version.str();
+}
+
+// name#hash, false for lines written before versions were recorded
+static bool parseVersion(const std::string &version, std::string &name)
+{
+	size_t pos = version.find('#');
+	if (pos == std::string::npos)
+		return false;
+	name = version.substr(0, pos);
+	return true;
+}
+
+bool PairGameCache::load(const std::string &path)
+{
+	{
+		std::ifstream in(path);
+		std::string line;
+		while (std::getline(in, line))
+		{
+			std::istringstream str(line);
+			PairGame game;
+			if (str >> game.leftVersion >> game.rightVersion >> game.game >> game.scores[0] >> game.scores[1]
+				&& parseVersion(game.leftVersion, game.left) && parseVersion(game.rightVersion, game.right))
+				games[Key(game.leftVersion, game.rightVersion, game.game)] = game;
+		}
+	}
+
+	out.open(path, std::ios::app);
+	if (!out)
+	{
+		std::cerr << "Can't open cache " << path << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+void PairGameCache::add(const PairGame &game, bool persistent)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	games[Key(game.leftVersion, game.rightVersion, game.game)] = game;
+	if (persistent)
+		out << game.leftVersion << " " << game.rightVersion << " " << game.game << " " << game.scores[0] << " " << game.scores[1] << std::endl;
+}
+
+// Inverse of a small dense matrix by Gauss-Jordan elimination
+static std::vector<std::vector<double>> invert(std::vector<std::vector<double>> a)
+{
+	int n = a.size();
+	std::vector<std::vector<double>> res(n, std::vector<double>(n));
+	for (int i = 0; i < n; ++i)
+		res[i][i] = 1.0;
+
+	for (int col = 0; col < n; ++col)
+	{
+		int pivot = col;
+		for (int row = col + 1; row < n; ++row)
+		{
+			if (std::abs(a[row][col]) > std::abs(a[pivot][col]))
+				pivot = row;
+		}
+		std::swap(a[col], a[pivot]);
+		std::swap(res[col], res[pivot]);
+
+		double d = a[col][col];
+		if (std::abs(d) < 1e-12)
+			continue;
+
+		for (int j = 0; j < n; ++j)
+		{
+			a[col][j] /= d;
+			res[col][j] /= d;
+		}
+
+		for (int row = 0; row < n; ++row)
+		{
+			if (row == col)
+				continue;
+
+			double k = a[row][col];
+			for (int j = 0; j < n; ++j)
+			{
+				a[row][j] -= k * a[col][j];
+				res[row][j] -= k * res[col][j];
+			}
+		}
+	}
+
+	return res;
+}
+
+void RatingTable::fit(const std::vector<std::string> &names, const std::vector<PairGame> &games)
+{
+	const double ELO_SCALE = 400.0 / std::log(10.0);
+	int n = names.size();
+	std::map<std::string, int> index;
+	for (int i = 0; i < n; ++i)
+		index[names[i]] = i;
+
+	// points[i][j] - points of i against j, count[i][j] - games between them
+	std::vector<std::vector<double>> points(n, std::vector<double>(n, 0.5));
+	std::vector<std::vector<double>> count(n, std::vector<double>(n, 1.0));
+	entries.assign(n, Entry());
+	for (int i = 0; i < n; ++i)
+	{
+		entries[i].name = names[i];
+		points[i][i] = count[i][i] = 0.0;
+	}
+
+	for (const PairGame &game : games)
+	{
+		int l = index.at(game.left);
+		int r = index.at(game.right);
+		double leftPoints = game.scores[0] > game.scores[1] ? 1.0 : (game.scores[0] == game.scores[1] ? 0.5 : 0.0);
+		points[l][r] += leftPoints;
+		points[r][l] += 1.0 - leftPoints;
+		count[l][r] += 1.0;
+		count[r][l] += 1.0;
+		entries[l].points += leftPoints;
+		entries[r].points += 1.0 - leftPoints;
+		entries[l].games++;
+		entries[r].games++;
+	}
+
+	std::vector<double> gamma(n, 1.0);
+	for (int iter = 0; iter < 10000; ++iter)
+	{
+		double maxChange = 0.0;
+		std::vector<double> next(n);
+		for (int i = 0; i < n; ++i)
+		{
+			double wins = 0.0;
+			double denom = 0.0;
+			for (int j = 0; j < n; ++j)
+			{
+				if (j == i)
+					continue;
+				wins += points[i][j];
+				denom += count[i][j] / (gamma[i] + gamma[j]);
+			}
+			next[i] = denom > 0.0 ? wins / denom : 1.0;
+		}
+
+		double logMean = 0.0;
+		for (int i = 0; i < n; ++i)
+			logMean += std::log(next[i]) / n;
+
+		for (int i = 0; i < n; ++i)
+		{
+			next[i] /= std::exp(logMean);
+			maxChange = std::max(maxChange, std::abs(std::log(next[i] / gamma[i])));
+		}
+
+		gamma = next;
+		if (maxChange < 1e-10)
+			break;
+	}
+
+	// Covariance of centered log-strengths: pseudo-inverse of the information
+	// matrix (a weighted graph Laplacian), pinv(H) = inv(H + J/n) - J/n
+	std::vector<std::vector<double>> h(n, std::vector<double>(n, 1.0 / n));
+	for (int i = 0; i < n; ++i)
+	{
+		for (int j = 0; j < n; ++j)
+		{
+			if (i == j)
+				continue;
+
+			double p = gamma[i] / (gamma[i] + gamma[j]);
+			double info = count[i][j] * p * (1.0 - p);
+			h[i][j] -= info;
+			h[i][i] += info;
+		}
+	}
+
+	std::vector<std::vector<double>> cov = invert(h);
+	for (int i = 0; i < n; ++i)
+	{
+		entries[i].elo = ELO_SCALE * std::log(gamma[i]);
+		entries[i].eloError = 1.96 * ELO_SCALE * std::sqrt(std::max(0.0, cov[i][i] - 1.0 / n));
+	}
+
+	std::sort(entries.begin(), entries.end(), [](const Entry &e1, const Entry &e2) { return e1.elo > e2.elo; });
+}
+
+void RatingTable::print(std::ostream &out) const
+{
+	out << std::left << std::setw(12) << "NAME" << std::right << std::setw(9) << "ELO" << std::setw(9) << "+-95%"
+		<< std::setw(8) << "SCORE%" << std::setw(8) << "GAMES" << std::endl;
+	for (const Entry &entry : entries)
+	{
+		out << std::left << std::setw(12) << entry.name << std::right << std::fixed << std::setprecision(1)
+			<< std::setw(9) << entry.elo << std::setw(9) << entry.eloError
+			<< std::setw(8) << (entry.games ? entry.points * 100.0 / entry.games : 0.0)
+			<< std::setw(8) << entry.games << std::endl;
+	}
+	out << std::defaultfloat << std::setprecision(6);
+}
+
+void runRoundRobin(const StrategyRegistry &registry, const RoundRobinOptions &roundRobin, const TournamentOptions &options)
+{
+	// Timed, threaded and rand() versions only play when named and are never cached
+	std::vector<std::string> names = roundRobin.names;
+	if (names.empty())
+	{
+		for (const std::string &name : registry.getNames())
+		{
+			if (registry.getInfo(name).deterministic)
+				names.push_back(name);
+		}
+	}
+
+	PairGameCache cache;
+	if (!cache.load(roundRobin.cachePath))
+		return;
+
+	uint64_t buildHash = getBuildHash(roundRobin.binaryPath);
+	if (!buildHash)
+		std::cerr << "Can't read " << roundRobin.binaryPath << ", games won't be cached" << std::endl;
+
+	std::vector<std::string> versions(names.size());
+	std::map<std::string, std::string> nameByVersion;
+	for (size_t k = 0; k < names.size(); ++k)
+	{
+		versions[k] = buildHash && registry.getInfo(names[k]).deterministic ? getStrategyVersion(registry, names[k], buildHash) : names[k] + "#";
+		nameByVersion[versions[k]] = names[k];
+	}
+
+	// Every pair plays every seed twice, with swapped sides
+	std::vector<PairGameCache::Key> keys;
+	for (size_t a = 0; a < names.size(); ++a)
+	{
+		for (size_t b = a + 1; b < names.size(); ++b)
+		{
+			for (int game = 0; game < roundRobin.games; ++game)
+			{
+				keys.emplace_back(versions[a], versions[b], game);
+				keys.emplace_back(versions[b], versions[a], game);
+			}
+		}
+	}
+
+	std::vector<int> jobs;
+	for (size_t k = 0; k < keys.size(); ++k)
+	{
+		if (!cache.contains(keys[k]))
+			jobs.push_back(k);
+	}
+
+	std::cout << "ROUND ROBIN " << names.size() << " versions " << keys.size() << " games, cached "
+		<< (keys.size() - jobs.size()) << " to play " << jobs.size() << std::endl;
+
+	std::atomic<int> played(0);
+	playGames(jobs, [&](int k) {
+		const PairGameCache::Key &key = keys[k];
+		GameResult result = playMatch(registry.get(nameByVersion[std::get<0>(key)]),
+			registry.get(nameByVersion[std::get<1>(key)]), std::get<2>(key));
+		result.game = k;
+		return result;
+	}, options, [&](const GameResult &result) {
+		const PairGameCache::Key &key = keys[result.game];
+		PairGame game;
+		game.leftVersion = std::get<0>(key);
+		game.rightVersion = std::get<1>(key);
+		game.left = nameByVersion.at(game.leftVersion);
+		game.right = nameByVersion.at(game.rightVersion);
+		game.game = std::get<2>(key);
+		game.scores[0] = result.scores[0];
+		game.scores[1] = result.scores[1];
+		cache.add(game, buildHash && registry.getInfo(game.left).deterministic && registry.getInfo(game.right).deterministic);
+
+		std::ostringstream line;
+		line << ++played << "/" << jobs.size() << " " << game.left << " / " << game.right << " " << game.game
+			<< " - " << game.scores[0] << " -- " << game.scores[1] << "\n";
+		std::cout << line.str() << std::flush;
+	});
+
+	std::vector<PairGame> games;
+	for (const PairGameCache::Key &key : keys)
+		games.push_back(cache.get(key));
+
+	// Pairwise summary in the format of the old hand-written table: second / first
+	for (size_t a = 0; a < names.size(); ++a)
+	{
+		for (size_t b = a + 1; b < names.size(); ++b)
+		{
+			double totalA = 0, totalB = 0;
+			int wonB = 0, lossB = 0, count = 0;
+			for (const PairGame &game : games)
+			{
+				int sideA;
+				if (game.left == names[a] && game.right == names[b])
+					sideA = 0;
+				else if (game.left == names[b] && game.right == names[a])
+					sideA = 1;
+				else
+					continue;
+
+				int scoreA = game.scores[sideA];
+				int scoreB = game.scores[1 - sideA];
+				totalA += scoreA;
+				totalB += scoreB;
+				wonB += scoreB > scoreA;
+				lossB += scoreB < scoreA;
+				++count;
+			}
+
+			std::cout << names[b] << " / " << names[a] << " RES: " << ((totalB + 1) / (totalA + 1))
+				<< " " << (totalA / count) << " " << (totalB / count)
+				<< " W " << ((float) wonB * 100 / (float) count)
+				<< " L " << ((float) lossB * 100 / (float) count) << std::endl;
+		}
+	}
+
+	RatingTable table;
+	table.fit(names, games);
+	table.print(std::cout);
+}
@@ -0,0 +1,80 @@
+#ifndef RATING_HPP
+#define RATING_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "StrategyRegistry.hpp"
+#include "Tournament.hpp"
+
+// Scores of one round-robin game, key is (leftVersion, rightVersion, game)
+struct PairGame
+{
+	std::string left, right;
+	std::string leftVersion, rightVersion; // see getStrategyVersion
+	int game;
+	int scores[2];
+};
+
+// FNV-1a of the running arena executable, 0 if it can't be read
+uint64_t getBuildHash(const std::string &binaryPath);
+
+// "name#hash" of the factory config and the build, so the cache doesn't reuse
+// games of other --params, --evaluator or of any rebuilt code
+std::string getStrategyVersion(const StrategyRegistry &registry, const std::string &name, uint64_t buildHash);
+
+// Text cache of played round-robin games, one "leftVersion rightVersion game
+// scoreLeft scoreRight" line per game, so adding a version plays only its own
+// pairings. Lines of other versions stay in the file but are never matched.
+class PairGameCache
+{
+public:
+	typedef std::tuple<std::string, std::string, int> Key;
+
+	bool load(const std::string &path);
+	bool contains(const Key &key) const { return games.count(key) > 0; }
+	const PairGame &get(const Key &key) const { return games.at(key); }
+	// Thread safe, persistent - also append to the cache file opened by load()
+	void add(const PairGame &game, bool persistent);
+
+private:
+	std::map<Key, PairGame> games;
+	std::mutex mutex;
+	std::ofstream out;
+};
+
+// Bradley-Terry strengths fitted with the MM algorithm. Each pair gets one
+// virtual draw so that a 100% score stays finite.
+struct RatingTable
+{
+	struct Entry
+	{
+		std::string name;
+		double elo = 0.0;       // mean of all versions is 0
+		double eloError = 0.0;  // 95% confidence half-width from the Fisher information
+		double points = 0.0;    // win = 1, draw = 0.5
+		int games = 0;
+	};
+
+	std::vector<Entry> entries; // sorted by elo, strongest first
+
+	void fit(const std::vector<std::string> &names, const std::vector<PairGame> &games);
+	void print(std::ostream &out) const;
+};
+
+struct RoundRobinOptions
+{
+	std::vector<std::string> names; // empty - every registered deterministic version
+	int games = 50;                 // seeds per pair, each played with both side assignments
+	std::string cachePath = "roundrobin.cache";
+	std::string binaryPath;         // argv[0], hashed where /proc/self/exe isn't available
+};
+
+void runRoundRobin(const StrategyRegistry &registry, const RoundRobinOptions &roundRobin, const TournamentOptions &options);
+
+#endif
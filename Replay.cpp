@@ -0,0 +1,636 @@
+#include "Replay.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+static const char REPLAY_MAGIC[4] = {'C', 'L', 'R', 'P'};
+static const uint32_t REPLAY_VERSION = 1;
+
+static void writeVarint(std::vector<uint8_t> &out, uint32_t value)
+{
+	while (value >= 0x80)
+	{
+		out.push_back((uint8_t) (value | 0x80));
+		value >>= 7;
+	}
+	out.push_back((uint8_t) value);
+}
+
+static bool readVarint(const std::vector<uint8_t> &in, size_t &pos, uint32_t &value)
+{
+	value = 0;
+	for (int shift = 0; shift < 35 && pos < in.size(); shift += 7)
+	{
+		uint8_t byte = in[pos++];
+		value |= (uint32_t) (byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			return true;
+	}
+	return false;
+}
+
+static void writeString(std::vector<uint8_t> &out, const std::string &str)
+{
+	writeVarint(out, str.size());
+	out.insert(out.end(), str.begin(), str.end());
+}
+
+static bool readString(const std::vector<uint8_t> &in, size_t &pos, std::string &str)
+{
+	uint32_t size;
+	if (!readVarint(in, pos, size) || in.size() - pos < size)
+		return false;
+	str.assign(in.begin() + pos, in.begin() + pos + size);
+	pos += size;
+	return true;
+}
+
+// Skips the tick records, pos ends after the 0 terminator
+static bool skipCommands(const std::vector<uint8_t> &in, size_t &pos)
+{
+	uint32_t value, count, elevators;
+	while (true)
+	{
+		if (!readVarint(in, pos, value))
+			return false;
+		if (!value)
+			return true;
+
+		if (!readVarint(in, pos, count))
+			return false;
+		for (uint32_t i = 0; i < count * 2; ++i)
+		{
+			if (!readVarint(in, pos, value))
+				return false;
+		}
+
+		if (!readVarint(in, pos, count))
+			return false;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			if (!readVarint(in, pos, value) || !readVarint(in, pos, elevators))
+				return false;
+			for (uint32_t j = 0; j < elevators; ++j)
+			{
+				if (!readVarint(in, pos, value))
+					return false;
+			}
+		}
+	}
+}
+
+bool saveReplay(const std::string &path, const Replay &replay)
+{
+	std::vector<uint8_t> data(REPLAY_MAGIC, REPLAY_MAGIC + 4);
+	writeVarint(data, REPLAY_VERSION);
+	writeVarint(data, replay.game);
+	writeVarint(data, replay.m_w);
+	writeVarint(data, replay.m_z);
+	writeString(data, replay.left);
+	writeString(data, replay.right);
+	data.insert(data.end(), replay.commands.begin(), replay.commands.end());
+	writeVarint(data, replay.ticks);
+	writeVarint(data, replay.scores[0]);
+	writeVarint(data, replay.scores[1]);
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	out.write((const char *) data.data(), data.size());
+	if (!out)
+	{
+		std::cerr << "Can't write replay " << path << std::endl;
+		return false;
+	}
+	return true;
+}
+
+std::string getReplayIndexPath(const std::string &replayPath)
+{
+	size_t dot = replayPath.rfind(".clrp");
+	if (dot != std::string::npos && dot + 5 == replayPath.size())
+		return replayPath.substr(0, dot) + ".clrk";
+	return replayPath + ".clrk";
+}
+
+bool loadReplay(const std::string &path, Replay &replay)
+{
+	std::ifstream in(path, std::ios::binary);
+	std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	if (data.size() < 4 || memcmp(data.data(), REPLAY_MAGIC, 4))
+	{
+		std::cerr << "Not a replay " << path << std::endl;
+		return false;
+	}
+
+	size_t pos = 4;
+	uint32_t version, game, ticks, scores[2];
+	bool ok = readVarint(data, pos, version) && version == REPLAY_VERSION
+		&& readVarint(data, pos, game) && readVarint(data, pos, replay.m_w) && readVarint(data, pos, replay.m_z)
+		&& readString(data, pos, replay.left) && readString(data, pos, replay.right);
+
+	size_t commandsBegin = pos;
+	ok = ok && skipCommands(data, pos);
+	size_t commandsEnd = pos;
+	ok = ok && readVarint(data, pos, ticks) && readVarint(data, pos, scores[0]) && readVarint(data, pos, scores[1]);
+	if (!ok)
+	{
+		std::cerr << "Broken replay " << path << std::endl;
+		return false;
+	}
+
+	replay.game = game;
+	replay.ticks = ticks;
+	replay.scores[0] = scores[0];
+	replay.scores[1] = scores[1];
+	replay.commands.assign(data.begin() + commandsBegin, data.begin() + commandsEnd);
+	return true;
+}
+
+ReplayRecorder::ReplayRecorder(const std::string &left, const std::string &right)
+{
+	replay.left = left;
+	replay.right = right;
+}
+
+void ReplayRecorder::begin(const Simulator &sim, int game)
+{
+	replay.game = game;
+	replay.commands.clear();
+	replay.m_w = sim.random.m_w;
+	replay.m_z = sim.random.m_z;
+	lastTick = sim.tick;
+}
+
+void ReplayRecorder::recordCommands(const Simulator &sim)
+{
+	int tick = sim.tick + 1; // tick of the coming step()
+
+	std::vector<const MyElevator *> elevators;
+	for (const MyElevator &elevator : sim.elevators)
+	{
+		if (elevator.go_to_floor != -1 && elevator.state != EState::MOVING && elevator.go_to_floor != elevator.next_floor)
+			elevators.push_back(&elevator);
+	}
+
+	std::vector<const MyPassenger *> passengers;
+	for (const std::pair<const int, MyPassenger> &entry : sim.passengers)
+	{
+		const MyPassenger &passenger = entry.second;
+		if (passenger.elevator == -1 && !passenger.set_elevator.empty()
+			&& (passenger.state == PState::WAITING_FOR_ELEVATOR || passenger.state == PState::RETURNING))
+		{
+			passengers.push_back(&passenger);
+		}
+	}
+
+	if (elevators.empty() && passengers.empty())
+		return;
+
+	std::sort(passengers.begin(), passengers.end(), [](const MyPassenger *p1, const MyPassenger *p2) { return p1->id < p2->id; });
+
+	std::vector<uint8_t> &out = replay.commands;
+	writeVarint(out, tick - lastTick);
+	lastTick = tick;
+
+	writeVarint(out, elevators.size());
+	for (const MyElevator *elevator : elevators)
+	{
+		writeVarint(out, elevator->id);
+		writeVarint(out, elevator->go_to_floor);
+	}
+
+	writeVarint(out, passengers.size());
+	int prevId = 0;
+	for (const MyPassenger *passenger : passengers)
+	{
+		writeVarint(out, passenger->id - prevId);
+		prevId = passenger->id;
+		writeVarint(out, passenger->set_elevator.size());
+		for (int id : passenger->set_elevator)
+			writeVarint(out, id);
+	}
+}
+
+void ReplayRecorder::finish(const Simulator &sim)
+{
+	writeVarint(replay.commands, 0);
+	replay.ticks = sim.tick + 1;
+	replay.scores[0] = sim.scores[0];
+	replay.scores[1] = sim.scores[1];
+}
+
+ReplayPlayer::ReplayPlayer(const Replay &replay) : replay(replay)
+{
+	sim.random.m_w = replay.m_w;
+	sim.random.m_z = replay.m_z;
+	readNextTick();
+}
+
+void ReplayPlayer::readNextTick()
+{
+	uint32_t delta;
+	if (readVarint(replay.commands, pos, delta) && delta)
+	{
+		recordTick += delta;
+		nextTick = recordTick;
+	}
+	else
+		nextTick = -1;
+}
+
+bool ReplayPlayer::step()
+{
+	if (played >= replay.ticks)
+		return false;
+
+	if (nextTick == played)
+	{
+		uint32_t count, id, value, elevators;
+		readVarint(replay.commands, pos, count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			readVarint(replay.commands, pos, id);
+			readVarint(replay.commands, pos, value);
+			if (id < sim.elevators.size())
+				sim.elevators[id].go_to_floor = value;
+		}
+
+		readVarint(replay.commands, pos, count);
+		int passengerId = 0;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			readVarint(replay.commands, pos, id);
+			passengerId += id;
+			readVarint(replay.commands, pos, elevators);
+			Simulator::Passengers::iterator it = sim.passengers.find(passengerId);
+			for (uint32_t j = 0; j < elevators; ++j)
+			{
+				readVarint(replay.commands, pos, value);
+				if (it != sim.passengers.end())
+					it->second.set_elevator.insert(value);
+			}
+		}
+
+		readNextTick();
+	}
+
+	sim.step();
+	++played;
+	return true;
+}
+
+bool ReplayPlayer::seek(int tick)
+{
+	while (sim.tick < tick)
+	{
+		if (!step())
+			return false;
+	}
+	return true;
+}
+
+namespace
+{
+	template <typename T>
+	void put(std::vector<uint8_t> &out, const T &value)
+	{
+		const uint8_t *bytes = (const uint8_t *) &value;
+		out.insert(out.end(), bytes, bytes + sizeof(T));
+	}
+
+	template <typename T>
+	bool get(const std::vector<uint8_t> &in, size_t &pos, T &value)
+	{
+		if (in.size() - pos < sizeof(T))
+			return false;
+		memcpy(&value, in.data() + pos, sizeof(T));
+		pos += sizeof(T);
+		return true;
+	}
+
+	void putSet(std::vector<uint8_t> &out, const std::set<int> &values)
+	{
+		put<int32_t>(out, values.size());
+		for (int value : values)
+			put<int32_t>(out, value);
+	}
+
+	bool getSet(const std::vector<uint8_t> &in, size_t &pos, std::set<int> &values)
+	{
+		int32_t size, value;
+		if (!get(in, pos, size))
+			return false;
+		values.clear();
+		for (int i = 0; i < size; ++i)
+		{
+			if (!get(in, pos, value))
+				return false;
+			values.insert(values.end(), value);
+		}
+		return true;
+	}
+
+	void putPassenger(std::vector<uint8_t> &out, const MyPassenger &p)
+	{
+		put<int32_t>(out, p.id);
+		put(out, p.x);
+		put(out, p.y);
+		put(out, p.spawn_x);
+		put<int32_t>(out, p.from_floor);
+		put<int32_t>(out, p.dest_floor);
+		put<int32_t>(out, p.time_to_away);
+		put<int32_t>(out, (int) p.side);
+		put<int32_t>(out, p.elevator);
+		put<int32_t>(out, (int) p.state);
+		put<int32_t>(out, p.ticks);
+		put<int32_t>(out, p.placesRemained);
+		// only the places still to visit are set, dest_floor_confirmed is left
+		// uninitialized for spawned passengers: write them normalized
+		for (int i = 0; i < 5; ++i)
+			put<int32_t>(out, i < p.placesRemained ? p.places[i] : 0);
+		put<uint32_t>(out, p.visitedLevels.to_ulong());
+		put(out, p.mass);
+		uint8_t confirmed;
+		memcpy(&confirmed, &p.dest_floor_confirmed, 1);
+		put<uint8_t>(out, confirmed != 0);
+		putSet(out, p.set_elevator);
+	}
+
+	bool getPassenger(const std::vector<uint8_t> &in, size_t &pos, MyPassenger &p)
+	{
+		int32_t id, fromFloor, destFloor, timeToAway, side, elevator, state, ticks, placesRemained, places[5];
+		uint32_t visited;
+		uint8_t confirmed;
+		bool ok = get(in, pos, id) && get(in, pos, p.x) && get(in, pos, p.y) && get(in, pos, p.spawn_x)
+			&& get(in, pos, fromFloor) && get(in, pos, destFloor) && get(in, pos, timeToAway)
+			&& get(in, pos, side) && get(in, pos, elevator) && get(in, pos, state)
+			&& get(in, pos, ticks) && get(in, pos, placesRemained) && get(in, pos, places)
+			&& get(in, pos, visited) && get(in, pos, p.mass) && get(in, pos, confirmed)
+			&& getSet(in, pos, p.set_elevator);
+		if (!ok)
+			return false;
+
+		p.id = id;
+		p.from_floor = fromFloor;
+		p.dest_floor = destFloor;
+		p.time_to_away = timeToAway;
+		p.side = (Side) side;
+		p.elevator = elevator;
+		p.state = (PState) state;
+		p.ticks = ticks;
+		p.placesRemained = placesRemained;
+		std::copy(places, places + 5, p.places);
+		p.visitedLevels = std::bitset<LEVELS_COUNT>(visited);
+		p.dest_floor_confirmed = confirmed;
+		return true;
+	}
+}
+
+void serializeSimulator(const Simulator &sim, std::vector<uint8_t> &out)
+{
+	put<int32_t>(out, sim.tick);
+	put<int32_t>(out, sim.cur_pass_seq);
+	put(out, sim.random.m_w);
+	put(out, sim.random.m_z);
+	put(out, sim.scores);
+	put(out, sim.scoresByElevators);
+	put(out, sim.passengersTotal);
+
+	put<int32_t>(out, sim.elevators.size());
+	for (const MyElevator &e : sim.elevators)
+	{
+		put<int32_t>(out, e.id);
+		put<int32_t>(out, e.ind);
+		put(out, e.x);
+		put(out, e.y);
+		put(out, e.speed);
+		put<int32_t>(out, e.time_on_the_floor_with_opened_doors);
+		put<int32_t>(out, e.closing_or_opening_ticks);
+		put<int32_t>(out, e.next_floor);
+		put(out, e.time_to_floor);
+		put<int32_t>(out, (int) e.side);
+		put<int32_t>(out, (int) e.state);
+		putSet(out, e.passengers);
+		put<int32_t>(out, e.go_to_floor);
+	}
+
+	put<int32_t>(out, sim.passengers.bucket_count());
+	put<int32_t>(out, sim.passengers.size());
+	for (const std::pair<const int, MyPassenger> &entry : sim.passengers)
+		putPassenger(out, entry.second);
+
+	put<int32_t>(out, sim.outPassengers.size());
+	for (const std::pair<const int, MyPassenger> &entry : sim.outPassengers)
+	{
+		put<int32_t>(out, entry.first);
+		putPassenger(out, entry.second);
+	}
+}
+
+bool deserializeSimulator(const std::vector<uint8_t> &in, size_t &pos, Simulator &sim)
+{
+	int32_t tick, seq, count;
+	if (!get(in, pos, tick) || !get(in, pos, seq) || !get(in, pos, sim.random.m_w) || !get(in, pos, sim.random.m_z)
+		|| !get(in, pos, sim.scores) || !get(in, pos, sim.scoresByElevators) || !get(in, pos, sim.passengersTotal)
+		|| !get(in, pos, count) || count != (int32_t) sim.elevators.size())
+	{
+		return false;
+	}
+	sim.tick = tick;
+	sim.cur_pass_seq = seq;
+
+	for (MyElevator &e : sim.elevators)
+	{
+		int32_t id, ind, time, ticks, nextFloor, side, state, goToFloor;
+		if (!get(in, pos, id) || !get(in, pos, ind) || !get(in, pos, e.x) || !get(in, pos, e.y) || !get(in, pos, e.speed)
+			|| !get(in, pos, time) || !get(in, pos, ticks) || !get(in, pos, nextFloor) || !get(in, pos, e.time_to_floor)
+			|| !get(in, pos, side) || !get(in, pos, state) || !getSet(in, pos, e.passengers) || !get(in, pos, goToFloor))
+		{
+			return false;
+		}
+		e.id = id;
+		e.ind = ind;
+		e.time_on_the_floor_with_opened_doors = time;
+		e.closing_or_opening_ticks = ticks;
+		e.next_floor = nextFloor;
+		e.side = (Side) side;
+		e.state = (EState) state;
+		e.go_to_floor = goToFloor;
+	}
+
+	int32_t buckets;
+	if (!get(in, pos, buckets) || !get(in, pos, count))
+		return false;
+
+	std::vector<MyPassenger> passengers(count);
+	for (MyPassenger &p : passengers)
+	{
+		if (!getPassenger(in, pos, p))
+			return false;
+	}
+
+	// A new key goes to the front of its bucket, or of the whole list if the
+	// bucket is empty, so inserting in reverse restores the iteration order
+	sim.passengers.clear();
+	sim.passengers.rehash(buckets);
+	for (auto it = passengers.rbegin(); it != passengers.rend(); ++it)
+		sim.passengers.emplace(it->id, *it);
+
+	if (!get(in, pos, count))
+		return false;
+
+	sim.outPassengers.clear();
+	for (int i = 0; i < count; ++i)
+	{
+		int32_t key;
+		MyPassenger p;
+		if (!get(in, pos, key) || !getPassenger(in, pos, p))
+			return false;
+		sim.outPassengers.emplace_hint(sim.outPassengers.end(), key, p);
+	}
+
+	return true;
+}
+
+ReplayIndex::Source::Source(const Replay &replay) : game(replay.game), ticks(replay.ticks), size(replay.commands.size())
+{
+	hash = 2166136261u;
+	for (uint8_t byte : replay.commands)
+		hash = (hash ^ byte) * 16777619u;
+}
+
+bool ReplayIndex::Source::operator == (const Source &other) const
+{
+	return game == other.game && ticks == other.ticks && size == other.size && hash == other.hash;
+}
+
+void ReplayIndex::build(const Replay &replay, int interval)
+{
+	source = Source(replay);
+	this->interval = std::max(1, interval);
+	keyframes.clear();
+
+	ReplayPlayer player(replay);
+	do
+	{
+		if (player.played % this->interval == 0)
+		{
+			Keyframe keyframe;
+			keyframe.tick = player.getTick();
+			keyframe.pos = player.pos;
+			keyframe.nextTick = player.nextTick;
+			serializeSimulator(player.sim, keyframe.state);
+			keyframes.push_back(std::move(keyframe));
+		}
+	} while (player.step());
+}
+
+static const char INDEX_MAGIC[4] = {'C', 'L', 'R', 'K'};
+static const int32_t INDEX_VERSION = 2;
+
+bool ReplayIndex::save(const std::string &path) const
+{
+	std::vector<uint8_t> data(INDEX_MAGIC, INDEX_MAGIC + 4);
+	put<int32_t>(data, INDEX_VERSION);
+	put<int32_t>(data, source.game);
+	put<int32_t>(data, source.ticks);
+	put<uint32_t>(data, source.size);
+	put<uint32_t>(data, source.hash);
+	put<int32_t>(data, interval);
+	put<int32_t>(data, keyframes.size());
+	for (const Keyframe &keyframe : keyframes)
+	{
+		put<int32_t>(data, keyframe.tick);
+		put<uint32_t>(data, keyframe.pos);
+		put<int32_t>(data, keyframe.nextTick);
+		put<uint32_t>(data, keyframe.state.size());
+		data.insert(data.end(), keyframe.state.begin(), keyframe.state.end());
+	}
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	out.write((const char *) data.data(), data.size());
+	if (!out)
+	{
+		std::cerr << "Can't write replay index " << path << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool ReplayIndex::load(const std::string &path, const Replay &replay)
+{
+	std::ifstream in(path, std::ios::binary);
+	if (!in)
+		return false;
+	std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+	size_t pos = 4;
+	int32_t version, count;
+	bool ok = data.size() >= 4 && !memcmp(data.data(), INDEX_MAGIC, 4) && get(data, pos, version) && version == INDEX_VERSION
+		&& get(data, pos, source.game) && get(data, pos, source.ticks) && get(data, pos, source.size) && get(data, pos, source.hash)
+		&& get(data, pos, interval) && get(data, pos, count) && count > 0 && interval > 0;
+
+	keyframes.assign(ok ? count : 0, Keyframe());
+	for (Keyframe &keyframe : keyframes)
+	{
+		uint32_t size;
+		if (!get(data, pos, keyframe.tick) || !get(data, pos, keyframe.pos) || !get(data, pos, keyframe.nextTick) || !get(data, pos, size)
+			|| data.size() - pos < size)
+		{
+			ok = false;
+			break;
+		}
+		keyframe.state.assign(data.begin() + pos, data.begin() + pos + size);
+		pos += size;
+	}
+
+	if (!ok || !isValid(replay))
+	{
+		std::cerr << "Replay index " << path << " is broken or was built for another replay, ignored" << std::endl;
+		keyframes.clear();
+		return false;
+	}
+	return true;
+}
+
+// Keyframe k is at tick k*interval - 1 (before the first step the tick is -1),
+// positions don't go back and the next record is not played yet
+bool ReplayIndex::isValid(const Replay &replay) const
+{
+	if (!(source == Source(replay)))
+		return false;
+
+	uint32_t prevPos = 0;
+	for (size_t k = 0; k < keyframes.size(); ++k)
+	{
+		const Keyframe &keyframe = keyframes[k];
+		if (keyframe.tick != (int) k * interval - 1 || keyframe.tick >= replay.ticks
+			|| keyframe.pos < prevPos || keyframe.pos > replay.commands.size()
+			|| (keyframe.nextTick != -1 && (keyframe.nextTick <= keyframe.tick || keyframe.nextTick >= replay.ticks)))
+			return false;
+		prevPos = keyframe.pos;
+	}
+	return true;
+}
+
+bool ReplayIndex::seek(ReplayPlayer &player, int tick) const
+{
+	auto it = std::upper_bound(keyframes.begin(), keyframes.end(), tick,
+		[](int t, const Keyframe &keyframe) { return t < keyframe.tick; });
+
+	// Restore only when going back or jumping past the next keyframe
+	if (it != keyframes.begin() && (tick < player.getTick() || (it - 1)->tick > player.getTick()))
+	{
+		const Keyframe &keyframe = *(it - 1);
+		size_t statePos = 0;
+		if (!deserializeSimulator(keyframe.state, statePos, player.sim))
+			return false;
+
+		player.played = keyframe.tick + 1;
+		player.pos = keyframe.pos;
+		player.recordTick = player.nextTick = keyframe.nextTick;
+	}
+
+	return player.seek(tick);
+}
@@ -0,0 +1,135 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Strategy.hpp"
+
+// Replay of one game: initial random state of the world simulator and the
+// commands of both sides, enough to re-run Simulator tick by tick.
+//
+// File: "CLRP" magic, then unsigned LEB128 varints:
+//   version, game, m_w, m_z, left name, right name (length + bytes),
+//   tick records, 0, ticks played, final scores[2]
+// Tick record, only for ticks with effective commands:
+//   tick - previous record tick (>= 1, the first one counts from -1),
+//   go_to_floor count, (elevator id, floor)...,
+//   set_elevator count, (passenger id - previous id, elevators count, elevator ids...)...
+// Commands that can't change the simulation (go_to_floor of a moving elevator
+// or to its next_floor, set_elevator of an already assigned passenger) are dropped.
+struct Replay
+{
+	std::string left, right;
+	int game = -1;
+	uint32_t m_w = 0, m_z = 0;
+	int ticks = 0;
+	int scores[2] = {};
+	std::vector<uint8_t> commands; // tick records with the 0 terminator
+};
+
+bool saveReplay(const std::string &path, const Replay &replay);
+// game_1.clrp -> game_1.clrk
+std::string getReplayIndexPath(const std::string &replayPath);
+bool loadReplay(const std::string &path, Replay &replay);
+
+class ReplayRecorder
+{
+public:
+	ReplayRecorder(const std::string &left, const std::string &right);
+
+	// sim is the world simulator before its first step
+	void begin(const Simulator &sim, int game);
+	// Call after both sides made their moves, right before sim.step()
+	void recordCommands(const Simulator &sim);
+	void finish(const Simulator &sim);
+
+	const Replay &getReplay() const { return replay; }
+
+private:
+	Replay replay;
+	int lastTick = -1;
+};
+
+// Full Simulator state in host byte order, doubles bit-exact. Passengers are
+// restored with the same bucket count and iteration order, so a restored
+// simulator steps exactly like the original one.
+void serializeSimulator(const Simulator &sim, std::vector<uint8_t> &out);
+bool deserializeSimulator(const std::vector<uint8_t> &in, size_t &pos, Simulator &sim);
+
+// Re-simulates a replay, sim is at tick getTick() after the last step()
+class ReplayPlayer
+{
+public:
+	explicit ReplayPlayer(const Replay &replay);
+
+	// false after the last recorded tick
+	bool step();
+	// Steps forward until sim.tick == tick
+	bool seek(int tick);
+	int getTick() const { return sim.tick; }
+
+	Simulator sim;
+
+private:
+	friend class ReplayIndex;
+
+	const Replay &replay;
+	size_t pos = 0;
+	int recordTick = -1;
+	int nextTick = -1; // tick of the next command record, -1 - no more records
+	int played = 0;
+
+	void readNextTick();
+};
+
+// Serialized player states every `interval` ticks, seek() restores the nearest
+// keyframe at or before the tick and re-simulates less than interval ticks.
+// Smaller interval - faster seek, bigger index (~10-25 KB per keyframe).
+//
+// File: "CLRK" magic, version, game, ticks, command stream size and FNV-1a
+// hash of the replay it was built for, interval, keyframe count, then per
+// keyframe: tick, command stream position and the tick of the record there,
+// size, serialized Simulator (all int32 / host order).
+class ReplayIndex
+{
+public:
+	// Re-simulates the whole replay once
+	void build(const Replay &replay, int interval);
+	bool save(const std::string &path) const;
+	// false if the file is missing, broken or was built for another replay
+	bool load(const std::string &path, const Replay &replay);
+
+	bool seek(ReplayPlayer &player, int tick) const;
+	int getInterval() const { return interval; }
+
+private:
+	struct Keyframe
+	{
+		int tick;
+		uint32_t pos;
+		int nextTick;
+		std::vector<uint8_t> state;
+	};
+
+	// Replay the index was built for
+	struct Source
+	{
+		int32_t game = -1;
+		int32_t ticks = 0;
+		uint32_t size = 0;
+		uint32_t hash = 0;
+
+		explicit Source(const Replay &replay);
+		Source() {}
+		bool operator == (const Source &other) const;
+	};
+
+	Source source;
+	int interval = 0;
+	std::vector<Keyframe> keyframes;
+
+	bool isValid(const Replay &replay) const;
+};
+
+#endif
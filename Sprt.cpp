@@ -0,0 +1,109 @@
+#include "Sprt.hpp"
+#include <cmath>
+
+static const char * getVerdictName(SprtVerdict verdict, bool enabled)
+{
+	if (!enabled)
+		return "off";
+	if (verdict == SprtVerdict::H1)
+		return "better";
+	if (verdict == SprtVerdict::H0)
+		return "not better";
+	return "undecided";
+}
+
+double Sprt::lowerBound() const
+{
+	return std::log(options.beta / (1.0 - options.alpha));
+}
+
+double Sprt::upperBound() const
+{
+	return std::log((1.0 - options.beta) / options.alpha);
+}
+
+double Sprt::winRateLlr() const
+{
+	double p0 = 0.5;
+	double p1 = 0.5 + options.winRateDelta;
+	return wins * std::log(p1 / p0) + losses * std::log((1.0 - p1) / (1.0 - p0));
+}
+
+double Sprt::ratioLlr() const
+{
+	if (games < 2)
+		return 0.0;
+
+	double mean = sumX / games;
+	double variance = (sumX2 - games * mean * mean) / (games - 1);
+	if (variance <= 0.0)
+		return 0.0;
+
+	double mu1 = std::log(options.scoreRatio);
+	return mu1 / variance * (sumX - games * mu1 * 0.5);
+}
+
+bool Sprt::add(const GameResult &result)
+{
+	++games;
+	if (result.scores[1] > result.scores[0])
+		++wins;
+	if (result.scores[1] < result.scores[0])
+		++losses;
+
+	double x = std::log((result.scores[1] + 1.0) / (result.scores[0] + 1.0));
+	sumX += x;
+	sumX2 += x * x;
+
+	if (games < options.minGames)
+		return false;
+
+	if (options.winRate && winRateVerdict == SprtVerdict::UNDECIDED)
+	{
+		double llr = winRateLlr();
+		if (llr >= upperBound())
+			winRateVerdict = SprtVerdict::H1;
+		else if (llr <= lowerBound())
+			winRateVerdict = SprtVerdict::H0;
+
+		if (winRateVerdict != SprtVerdict::UNDECIDED)
+			winRateGames = games;
+	}
+
+	if (options.ratio && ratioVerdict == SprtVerdict::UNDECIDED)
+	{
+		double llr = ratioLlr();
+		if (llr >= upperBound())
+			ratioVerdict = SprtVerdict::H1;
+		else if (llr <= lowerBound())
+			ratioVerdict = SprtVerdict::H0;
+
+		if (ratioVerdict != SprtVerdict::UNDECIDED)
+			ratioGames = games;
+	}
+
+	return finished();
+}
+
+bool Sprt::finished() const
+{
+	if (options.winRate && winRateVerdict == SprtVerdict::UNDECIDED)
+		return false;
+	if (options.ratio && ratioVerdict == SprtVerdict::UNDECIDED)
+		return false;
+	return options.winRate || options.ratio;
+}
+
+void Sprt::print(std::ostream &out, int maxGames) const
+{
+	out << "SPRT bounds [" << lowerBound() << ", " << upperBound() << "]"
+		<< " winrate(+" << options.winRateDelta << "): " << getVerdictName(winRateVerdict, options.winRate)
+		<< " llr " << winRateLlr();
+	if (winRateGames)
+		out << " at " << winRateGames;
+	out << " ratio(" << options.scoreRatio << "): " << getVerdictName(ratioVerdict, options.ratio)
+		<< " llr " << ratioLlr();
+	if (ratioGames)
+		out << " at " << ratioGames;
+	out << " games " << games << " of " << maxGames << " saved " << (maxGames - games) << std::endl;
+}
@@ -0,0 +1,57 @@
+#ifndef SPRT_HPP
+#define SPRT_HPP
+
+#include <ostream>
+#include "Tournament.hpp"
+
+// Sequential probability ratio tests for compareStrategies, the right side
+// is the tested strategy:
+//  - win rate: H0 p(win) = 0.5 against H1 p(win) = 0.5 + winRateDelta, draws are ignored;
+//  - score ratio: x = log((right + 1) / (left + 1)) per game, H0 mean 0 against
+//    H1 mean log(scoreRatio), normal with the sample variance.
+// Each test stops at LLR >= log((1 - beta) / alpha) (H1) or LLR <= log(beta / (1 - alpha)) (H0).
+struct SprtOptions
+{
+	bool enabled = false;
+	bool winRate = true;
+	bool ratio = true;
+	double alpha = 0.05;
+	double beta = 0.05;
+	double winRateDelta = 0.05;
+	double scoreRatio = 1.03;
+	int minGames = 20; // the variance estimate is useless before that
+};
+
+enum class SprtVerdict
+{
+	UNDECIDED,
+	H0,
+	H1
+};
+
+struct Sprt
+{
+	SprtOptions options;
+	int games = 0;
+	int wins = 0;
+	int losses = 0;
+	double sumX = 0.0;
+	double sumX2 = 0.0;
+	SprtVerdict winRateVerdict = SprtVerdict::UNDECIDED;
+	SprtVerdict ratioVerdict = SprtVerdict::UNDECIDED;
+	int winRateGames = 0; // games played when the verdict was reached
+	int ratioGames = 0;
+
+	explicit Sprt(const SprtOptions &options) : options(options) {}
+
+	// Must be called in game order, returns finished()
+	bool add(const GameResult &result);
+	bool finished() const;
+	double winRateLlr() const;
+	double ratioLlr() const;
+	double lowerBound() const;
+	double upperBound() const;
+	void print(std::ostream &out, int maxGames) const;
+};
+
+#endif
@@ -103,7 +103,7 @@ HEADER_OLNY_INLINE void Simulator::synchronizeWith(const Simulator &sim)
 			thisPass.placesRemained = 5 - thisPass.visitedLevels.count();
 			if (thisPass.placesRemained > 4)
 			{
-				std::cout << "ERROR number of places" << sim.tick << " " << thisPass.placesRemained << " id " << thisPass.id << std::endl;
+				LOGE(sim.tick, "ERROR number of places", thisPass.placesRemained, thisPass.id);
 				thisPass.placesRemained = 4;
 			}
 			
@@ -135,7 +135,7 @@ HEADER_OLNY_INLINE void Simulator::copyCommandsFrom(const Simulator &sim, Side s
 		const MyPassenger &otherPass = passenger.second;
 		bool exists = sim.passengers.count(id) > 0;
 		if (!exists)
-			std::cerr << "Passenger not found" << std::endl;
+			LOGE(sim.tick, "Passenger not found", id);
 		
 		MyPassenger &thisPass = passengers[id];
 		thisPass.set_elevator.insert(otherPass.set_elevator.begin(), otherPass.set_elevator.end());
@@ -319,7 +319,7 @@ HEADER_OLNY_INLINE void Simulator::simulatePassengers()
 					passenger.visitedLevels.set(passenger.dest_floor);
 					if (passenger.visitedLevels.count() > 6)
 					{
-						std::cout << "ERR" << std::endl;
+						LOGE(tick, "ERR visitedLevels", passenger.id);
 					}
 					outPassengers.insert(std::make_pair(tick + 500 + 40 - 1, passenger));
 				}
@@ -442,7 +442,7 @@ HEADER_OLNY_INLINE void MyElevator::setState(EState state, Simulator &sim)
 		for (int id : passengers)
 		{
 			if (!passengers.count(id))
-				std::cerr << sim.tick << " ERR PASS " << id << std::endl;
+				LOGE(sim.tick, "ERR PASS", id);
 			
 			MyPassenger &pass = sim.passengers[id];
 			totalMass *= pass.mass;
@@ -460,29 +460,35 @@ HEADER_OLNY_INLINE void MyElevator::setState(EState state, Simulator &sim)
 
 HEADER_OLNY_INLINE double MyElevator::calcTimeToFloor(double f, Simulator &sim) const
 {
-	double speed;
-	double time_to_floor;
-	if (passengers.size() <= 10)
-		speed = 1.0f / 50.0f;
-	else
-		speed = 1.0f / 50.0f / 1.1f;
-	
 	float totalMass = 1.0f;
 
 	for (int id : passengers)
 	{
 		if (!passengers.count(id))
-			std::cerr << sim.tick << " ERR PASS " << id << std::endl;
+			LOGE(sim.tick, "ERR PASS", id);
 		
 		MyPassenger &pass = sim.passengers[id];
 		totalMass *= pass.mass;
 	}
-	speed /= totalMass;
 	
-	if (f > getFloor())
-		time_to_floor = (f - getFloor()) / speed;
+	return calcTimeToFloor(getFloor(), f, passengers.size(), totalMass);
+}
+
+HEADER_OLNY_INLINE double MyElevator::calcTimeToFloor(int floor, double f, size_t passengersCount, float mass)
+{
+	double speed;
+	double time_to_floor;
+	if (passengersCount <= 10)
+		speed = 1.0f / 50.0f;
+	else
+		speed = 1.0f / 50.0f / 1.1f;
+	
+	speed /= mass;
+	
+	if (f > floor)
+		time_to_floor = (f - floor) / speed;
 	else
-		time_to_floor = (getFloor() - f) * 50.0;
+		time_to_floor = (floor - f) * 50.0;
 	return time_to_floor;
 }
 
@@ -700,7 +706,7 @@ HEADER_OLNY_INLINE double MyPassenger::getValue2(Side mySide) const
 	{
 		int cnt = visitedLevels.count();
 		if (cnt < 1 || cnt > 6)
-			std::cout << "ERR invalid visitedLevels "  << cnt << std::endl;
+			LOGE(LOG_NO_TICK, "ERR invalid visitedLevels", cnt);
 		
 		double avgDest = 0.0;
 		int k = 0;
@@ -713,7 +719,7 @@ HEADER_OLNY_INLINE double MyPassenger::getValue2(Side mySide) const
 				
 				if (i == from_floor)
 				{
-					std::cout << "ERR2 invalid visitedLevels "  << i << std::endl;
+					LOGE(LOG_NO_TICK, "ERR2 invalid visitedLevels", i);
 				}
 			}
 		}
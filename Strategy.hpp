@@ -7,6 +7,7 @@
 #include <unordered_map>
 #include <algorithm>
 #include <bitset>
+#include "AsyncLog.hpp"
 
 constexpr int LEVELS_COUNT = 9;
 constexpr int OPENING_TICS = 100;
@@ -82,6 +83,12 @@ struct MyPassenger
 	
 	double getValue2(Side mySide) const;
 	
+	// Destination after an out passenger comes out on its floor, as Simulator picks it
+	int getNextDestFloor() const
+	{
+		return placesRemained > 0 ? places[placesRemained - 1] : 0;
+	}
+	
 	std::set<int> set_elevator;
 };
 
@@ -110,6 +117,8 @@ struct MyElevator
 	
 	void setState(EState state, Simulator &sim);
 	double calcTimeToFloor(double f, Simulator &sim) const;
+	// calcTimeToFloor for any floor and cargo, mass - product of the passengers' masses
+	static double calcTimeToFloor(int floor, double f, size_t passengersCount, float mass);
 };
 
 struct Value {
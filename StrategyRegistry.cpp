@@ -0,0 +1,106 @@
+#include "StrategyRegistry.hpp"
+#include <iostream>
+#include "mystrategy.hpp"
+#include "OldStrategies.hpp"
+
+void StrategyRegistry::add(const std::string &name, const StrategyFactory &factory, bool deterministic, const std::string &config)
+{
+	if (!infos.count(name))
+		names.push_back(name);
+	StrategyInfo &info = infos[name];
+	info.factory = factory;
+	info.deterministic = deterministic;
+	info.config = config;
+}
+
+void StrategyRegistry::addFunction(const std::string &name, FunctionStrategy::MoveFunction function)
+{
+	add(name, [function](Side side, uint32_t) { return std::unique_ptr<IStrategy>(new FunctionStrategy(side, function)); });
+}
+
+bool StrategyRegistry::contains(const std::string &name) const
+{
+	return infos.count(name) > 0;
+}
+
+const StrategyFactory &StrategyRegistry::get(const std::string &name) const
+{
+	return infos.at(name).factory;
+}
+
+const StrategyInfo &StrategyRegistry::getInfo(const std::string &name) const
+{
+	return infos.at(name);
+}
+
+std::unique_ptr<IStrategy> StrategyRegistry::create(const std::string &name, Side side, uint32_t seed) const
+{
+	auto it = infos.find(name);
+	if (it == infos.end())
+	{
+		std::cerr << "Unknown strategy " << name << std::endl;
+		return std::unique_ptr<IStrategy>();
+	}
+
+	return it->second.factory(side, seed);
+}
+
+void registerStrategies(StrategyRegistry &registry)
+{
+	registry.addFunction("empty", nullptr);
+	registry.addFunction("makeMove", makeMove);
+	registry.addFunction("makeMove2", makeMove2);
+	registry.addFunction("makeMove3", makeMove3);
+	registry.addFunction("makeMove4", makeMove4);
+	registry.addFunction("makeMove5", makeMove5);
+	registry.addFunction("makeMove6", makeMove6);
+	registry.addFunction("makeMove7", makeMove7);
+	registry.addSimple<StratE1>("StratE1");
+	registry.addSimple<StratE2>("StratE2");
+	registry.addSimple<StratE3>("StratE3");
+	registry.addSimulating<strat2661::MyStrategy>("strat2661");
+	registry.addSimulating<strat2724::MyStrategy>("strat2724", false); // rand()
+	registry.addSimulating<strat2806::MyStrategy>("strat2806", false);
+	registry.addSimulating<strat3340::MyStrategy>("strat3340");
+	registry.addSimulating<strat3659::MyStrategy>("strat3659");
+	registry.addSimulating<strat3800::MyStrategy>("strat3800");
+	registry.addSimulating<strat3950::MyStrategy>("strat3950");
+	registry.addSimulating<strat4559::MyStrategy>("strat4559");
+	registry.addSimulating<strat4932::MyStrategy>("strat4932");
+	registry.addSimulating<MyStrategy>("MyStrategy");
+	registry.add("speculative", [](Side side, uint32_t seed) {
+		SimulatingStrategy<MyStrategy> *strategy = new SimulatingStrategy<MyStrategy>(side, seed);
+		strategy->strategy.setPlannerMode(PlannerMode::SPECULATIVE);
+		return std::unique_ptr<IStrategy>(strategy);
+	}, false);
+	registry.add("sliced", [](Side side, uint32_t seed) {
+		SimulatingStrategy<MyStrategy> *strategy = new SimulatingStrategy<MyStrategy>(side, seed);
+		strategy->strategy.setPlannerMode(PlannerMode::SLICED);
+		return std::unique_ptr<IStrategy>(strategy);
+	});
+	registry.add("joint", [](Side side, uint32_t seed) {
+		SimulatingStrategy<MyStrategy> *strategy = new SimulatingStrategy<MyStrategy>(side, seed);
+		strategy->strategy.setPlannerMode(PlannerMode::JOINT);
+		return std::unique_ptr<IStrategy>(strategy);
+	});
+	registry.add("mcts", [](Side side, uint32_t seed) {
+		SimulatingStrategy<MyStrategy> *strategy = new SimulatingStrategy<MyStrategy>(side, seed);
+		strategy->strategy.setPlannerMode(PlannerMode::MCTS);
+		return std::unique_ptr<IStrategy>(strategy);
+	}, false);
+	registry.add("beam", [](Side side, uint32_t seed) {
+		SimulatingStrategy<MyStrategy> *strategy = new SimulatingStrategy<MyStrategy>(side, seed);
+		strategy->strategy.setPlannerMode(PlannerMode::BEAM);
+		return std::unique_ptr<IStrategy>(strategy);
+	});
+	registry.add("rollouts-sweeper", [](Side side, uint32_t seed) {
+		SimulatingStrategy<MyStrategy> *strategy = new SimulatingStrategy<MyStrategy>(side, seed);
+		strategy->strategy.rolloutOpponent = OpponentModelType::SWEEPER;
+		return std::unique_ptr<IStrategy>(strategy);
+	});
+	registry.add("rollouts-mirror", [](Side side, uint32_t seed) {
+		SimulatingStrategy<MyStrategy> *strategy = new SimulatingStrategy<MyStrategy>(side, seed);
+		strategy->strategy.rolloutOpponent = OpponentModelType::MIRROR;
+		return std::unique_ptr<IStrategy>(strategy);
+	});
+}
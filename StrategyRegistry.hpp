@@ -0,0 +1,117 @@
+#ifndef STRATEGY_REGISTRY_HPP
+#define STRATEGY_REGISTRY_HPP
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Strategy.hpp"
+
+// Common interface of every strategy version that can play in the arena
+class IStrategy
+{
+public:
+	virtual ~IStrategy() {}
+
+	// Sets go_to_floor / set_elevator commands of its side in sim
+	virtual void makeMove(Simulator &sim) = 0;
+
+	// Shadow simulator of strategies that keep one, for the visualizer
+	virtual Simulator *getSimulator() { return nullptr; }
+};
+
+// Strategy with its own shadow simulator, T(Side) and T::makeMove(Simulator &),
+// seed != 0 reseeds the shadow simulator
+template <typename T>
+class SimulatingStrategy : public IStrategy
+{
+public:
+	SimulatingStrategy(Side side, uint32_t seed) : strategy(side)
+	{
+		if (seed)
+			strategy.sim.random.m_w = seed;
+	}
+
+	void makeMove(Simulator &sim) override { strategy.makeMove(sim); }
+	Simulator *getSimulator() override { return &strategy.sim; }
+
+	T strategy;
+};
+
+// Stateless T(Side) and T::makeMove(Simulator &)
+template <typename T>
+class SimpleStrategy : public IStrategy
+{
+public:
+	SimpleStrategy(Side side, uint32_t) : strategy(side) {}
+
+	void makeMove(Simulator &sim) override { strategy.makeMove(sim); }
+
+	T strategy;
+};
+
+// Free function makeMove(Side, Simulator &), nullptr - does nothing
+class FunctionStrategy : public IStrategy
+{
+public:
+	typedef void (*MoveFunction)(Side side, Simulator &sim);
+
+	FunctionStrategy(Side side, MoveFunction function) : side(side), function(function) {}
+
+	void makeMove(Simulator &sim) override
+	{
+		if (function)
+			function(side, sim);
+	}
+
+	Side side;
+	MoveFunction function;
+};
+
+typedef std::function<std::unique_ptr<IStrategy> (Side side, uint32_t seed)> StrategyFactory;
+
+struct StrategyInfo
+{
+	StrategyFactory factory;
+	bool deterministic = true; // same seeds - same game, false for timed or threaded planners and rand()
+	std::string config;        // settings the factory captures (params, evaluator weights)
+};
+
+class StrategyRegistry
+{
+public:
+	void add(const std::string &name, const StrategyFactory &factory, bool deterministic = true, const std::string &config = std::string());
+
+	template <typename T>
+	void addSimulating(const std::string &name, bool deterministic = true)
+	{
+		add(name, [](Side side, uint32_t seed) { return std::unique_ptr<IStrategy>(new SimulatingStrategy<T>(side, seed)); }, deterministic);
+	}
+
+	template <typename T>
+	void addSimple(const std::string &name)
+	{
+		add(name, [](Side side, uint32_t seed) { return std::unique_ptr<IStrategy>(new SimpleStrategy<T>(side, seed)); });
+	}
+
+	void addFunction(const std::string &name, FunctionStrategy::MoveFunction function);
+
+	bool contains(const std::string &name) const;
+	const StrategyFactory &get(const std::string &name) const;
+	const StrategyInfo &getInfo(const std::string &name) const;
+	// nullptr for unknown names
+	std::unique_ptr<IStrategy> create(const std::string &name, Side side, uint32_t seed) const;
+	// In registration order, oldest versions first
+	const std::vector<std::string> &getNames() const { return names; }
+
+private:
+	std::map<std::string, StrategyInfo> infos;
+	std::vector<std::string> names;
+};
+
+// Registers the current MyStrategy, the archived versions from OldStrategies.hpp and "empty"
+void registerStrategies(StrategyRegistry &registry);
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef HEADER_OLNY_INLINE
+#include "TickProfiler.hpp"
+#endif
+#include <algorithm>
+#include <iostream>
+
+#ifndef HEADER_OLNY_INLINE
+#define HEADER_OLNY_INLINE
+#define HEADER_OLNY_STATIC
+#endif
+
+HEADER_OLNY_STATIC const char * TICK_PHASE_NAMES[] = {
+	"sync",
+	"makeMove",
+	"commands",
+	"simStep"
+};
+HEADER_OLNY_INLINE const char * getTickPhaseName(TickPhase phase) {
+	return TICK_PHASE_NAMES[(int) phase];
+}
+
+HEADER_OLNY_INLINE int LatencyHistogram::bucketIndex(uint64_t value)
+{
+	if (value < SUB_COUNT)
+		return (int) value;
+
+	int msb = 63 - __builtin_clzll(value);
+	int exp = msb - SUB_BITS + 1;
+	return exp * HALF_COUNT + (int) (value >> exp);
+}
+
+HEADER_OLNY_INLINE uint64_t LatencyHistogram::bucketValue(int index)
+{
+	if (index < SUB_COUNT)
+		return index;
+
+	int exp = index / HALF_COUNT - 1;
+	uint64_t mantissa = index - exp * HALF_COUNT;
+	return mantissa << exp;
+}
+
+HEADER_OLNY_INLINE void LatencyHistogram::record(uint64_t value)
+{
+	counts[bucketIndex(value)]++;
+	totalCount++;
+	sum += value;
+	minValue = std::min(minValue, value);
+	maxValue = std::max(maxValue, value);
+}
+
+HEADER_OLNY_INLINE void LatencyHistogram::merge(const LatencyHistogram &other)
+{
+	for (int i = 0; i < BUCKETS_COUNT; ++i)
+		counts[i] += other.counts[i];
+	totalCount += other.totalCount;
+	sum += other.sum;
+	minValue = std::min(minValue, other.minValue);
+	maxValue = std::max(maxValue, other.maxValue);
+}
+
+HEADER_OLNY_INLINE uint64_t LatencyHistogram::percentile(double q) const
+{
+	if (!totalCount)
+		return 0;
+
+	uint64_t rank = (uint64_t) (q * totalCount);
+	if (rank >= totalCount)
+		return maxValue;
+
+	uint64_t seen = 0;
+	for (int i = 0; i < BUCKETS_COUNT; ++i)
+	{
+		seen += counts[i];
+		if (seen > rank)
+			return std::min(bucketValue(i), maxValue);
+	}
+
+	return maxValue;
+}
+
+HEADER_OLNY_INLINE double LatencyHistogram::mean() const
+{
+	if (!totalCount)
+		return 0.0;
+
+	return (double) sum / totalCount;
+}
+
+HEADER_OLNY_INLINE void TickProfiler::beginTick()
+{
+	tickStart = Clock::now();
+	phaseStart = tickStart;
+	std::fill(currentPhaseNs, currentPhaseNs + PHASES_COUNT, 0);
+}
+
+HEADER_OLNY_INLINE void TickProfiler::mark(TickPhase phase)
+{
+	Clock::time_point now = Clock::now();
+	currentPhaseNs[(int) phase] += std::chrono::duration_cast<std::chrono::nanoseconds>(now - phaseStart).count();
+	phaseStart = now;
+}
+
+HEADER_OLNY_INLINE void TickProfiler::endTick(int tick)
+{
+	uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - tickStart).count();
+	total.record(ns);
+	for (int i = 0; i < PHASES_COUNT; ++i)
+		phases[i].record(currentPhaseNs[i]);
+
+	if (budgetNs && ns > budgetNs)
+		++overBudgetTicks;
+
+	if (worst.size() < WORST_COUNT || ns > worst.back().ns)
+	{
+		Spike spike;
+		spike.tick = tick;
+		spike.ns = ns;
+		std::copy(currentPhaseNs, currentPhaseNs + PHASES_COUNT, spike.phaseNs);
+
+		auto pos = std::upper_bound(worst.begin(), worst.end(), spike, [](const Spike &s1, const Spike &s2) {
+			return s1.ns > s2.ns;
+		});
+		worst.insert(pos, spike);
+		if (worst.size() > WORST_COUNT)
+			worst.pop_back();
+	}
+}
+
+HEADER_OLNY_INLINE void TickProfiler::dump(std::ostream &out) const
+{
+	auto us = [](uint64_t ns) { return ns / 1000.0; };
+
+	out << "TICK LATENCY us: ticks " << total.totalCount
+		<< " mean " << us(total.mean())
+		<< " p50 " << us(total.percentile(0.5))
+		<< " p99 " << us(total.percentile(0.99))
+		<< " max " << us(total.maxValue);
+	if (budgetNs)
+		out << " budget " << us(budgetNs) << " over " << overBudgetTicks;
+	out << "\n";
+
+	for (int i = 0; i < PHASES_COUNT; ++i)
+	{
+		const LatencyHistogram &h = phases[i];
+		out << "  " << getTickPhaseName((TickPhase) i)
+			<< " mean " << us(h.mean())
+			<< " p50 " << us(h.percentile(0.5))
+			<< " p99 " << us(h.percentile(0.99))
+			<< " max " << us(h.maxValue) << "\n";
+	}
+
+	for (const Spike &spike : worst)
+	{
+		out << "  SPIKE tick " << spike.tick << " " << us(spike.ns);
+		for (int i = 0; i < PHASES_COUNT; ++i)
+			out << " " << getTickPhaseName((TickPhase) i) << " " << us(spike.phaseNs[i]);
+		out << "\n";
+	}
+	out.flush();
+}
@@ -0,0 +1,75 @@
+#ifndef TICK_PROFILER_HPP
+#define TICK_PROFILER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// HDR-style histogram: values below SUB_COUNT are exact, larger values keep
+// SUB_BITS - 1 significant bits (~3% relative error with SUB_BITS = 5).
+struct LatencyHistogram
+{
+	static constexpr int SUB_BITS = 5;
+	static constexpr int SUB_COUNT = 1 << SUB_BITS;
+	static constexpr int HALF_COUNT = SUB_COUNT / 2;
+	static constexpr int BUCKETS_COUNT = (64 - SUB_BITS) * HALF_COUNT + SUB_COUNT;
+
+	uint32_t counts[BUCKETS_COUNT] = {};
+	uint64_t totalCount = 0;
+	uint64_t sum = 0;
+	uint64_t minValue = UINT64_MAX;
+	uint64_t maxValue = 0;
+
+	void record(uint64_t value);
+	void merge(const LatencyHistogram &other);
+	uint64_t percentile(double q) const;
+	double mean() const;
+
+	static int bucketIndex(uint64_t value);
+	static uint64_t bucketValue(int index);
+};
+
+enum class TickPhase
+{
+	SYNC,
+	MAKE_MOVE,
+	COMMANDS,
+	SIM_STEP,
+	COUNT
+};
+
+const char * getTickPhaseName(TickPhase phase);
+
+// Per-tick wall time of Strategy::on_tick split by phase, plus the ticks
+// responsible for the worst spikes.
+struct TickProfiler
+{
+	typedef std::chrono::steady_clock Clock;
+	static constexpr int PHASES_COUNT = (int) TickPhase::COUNT;
+	static constexpr size_t WORST_COUNT = 10;
+
+	struct Spike
+	{
+		int tick;
+		uint64_t ns;
+		uint64_t phaseNs[PHASES_COUNT];
+	};
+
+	LatencyHistogram total;
+	LatencyHistogram phases[PHASES_COUNT];
+	std::vector<Spike> worst; // sorted by ns, descending
+	uint64_t budgetNs = 0;    // 0 - no budget check
+	int overBudgetTicks = 0;
+
+	void beginTick();
+	void mark(TickPhase phase);
+	void endTick(int tick);
+	void dump(std::ostream &out) const;
+
+private:
+	Clock::time_point tickStart, phaseStart;
+	uint64_t currentPhaseNs[PHASES_COUNT] = {};
+};
+
+#endif
@@ -0,0 +1,307 @@
+#include "Tournament.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+#ifdef _LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+GameResult makeGameResult(int game, Simulator &sim)
+{
+	GameResult result;
+	result.game = game;
+	for (int i = 0; i < 2; ++i)
+	{
+		result.scores[i] = sim.scores[i];
+		result.passengersTotal[i] = sim.passengersTotal[i];
+	}
+
+	for (int i = 0; i < 8; ++i)
+		result.scoresByElevators[i] = sim.scoresByElevators[i];
+
+	result.remaining[0] = sim.totalCargoValue(Side::LEFT).points;
+	result.remaining[1] = sim.totalCargoValue(Side::RIGHT).points;
+	return result;
+}
+
+GameResult playMatch(const StrategyFactory &left, const StrategyFactory &right, int game, ReplayRecorder *recorder)
+{
+	Simulator simulator;
+	simulator.random.m_w = MATCH_SEED_BASE + game*12345;
+	std::unique_ptr<IStrategy> stratLeft = left(Side::LEFT, 30000 + game*89741);
+	std::unique_ptr<IStrategy> stratRight = right(Side::RIGHT, 0);
+	if (recorder)
+		recorder->begin(simulator, game);
+	for (int j = 0; j < 7200; ++j)
+	{
+		stratLeft->makeMove(simulator);
+		stratRight->makeMove(simulator);
+		if (recorder)
+			recorder->recordCommands(simulator);
+		simulator.step();
+	}
+	if (recorder)
+		recorder->finish(simulator);
+
+	return makeGameResult(game, simulator);
+}
+
+static void pinThread(std::thread &thread, int cpu)
+{
+#ifdef _LINUX
+	cpu_set_t cpuset;
+	CPU_ZERO(&cpuset);
+	CPU_SET(cpu, &cpuset);
+	if (pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuset))
+		std::cerr << "Can't pin thread to cpu " << cpu << std::endl;
+#else
+	(void) thread;
+	(void) cpu;
+#endif
+}
+
+std::vector<GameResult> playGames(int first, int count, const GameFunction &play,
+	const TournamentOptions &options, const GameCallback &onFinished)
+{
+	std::vector<int> games(count);
+	for (int k = 0; k < count; ++k)
+		games[k] = first + k;
+
+	return playGames(games, play, options, onFinished);
+}
+
+std::vector<GameResult> playGames(const std::vector<int> &games, const GameFunction &play,
+	const TournamentOptions &options, const GameCallback &onFinished, const std::atomic<bool> *stop)
+{
+	int count = games.size();
+	std::vector<GameResult> results(count);
+	std::atomic<int> nextGame(0);
+
+	auto worker = [&]() {
+		for (int k = nextGame++; k < count; k = nextGame++)
+		{
+			if (stop && *stop)
+				break;
+
+			results[k] = play(games[k]);
+			if (onFinished)
+				onFinished(results[k]);
+		}
+	};
+
+	int threadsCount = std::max(1, std::min(options.threads, count));
+	int cpus = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<std::thread> threads;
+	for (int i = 0; i < threadsCount; ++i)
+	{
+		threads.emplace_back(worker);
+		if (options.affinity)
+			pinThread(threads.back(), (options.firstCpu + i) % cpus);
+	}
+
+	for (std::thread &thread : threads)
+		thread.join();
+
+	return results;
+}
+
+void getShardRange(int shard, int shards, int games, int &first, int &count)
+{
+	first = (int) ((int64_t) games * shard / shards);
+	count = (int) ((int64_t) games * (shard + 1) / shards) - first;
+}
+
+static const char RESULT_FILE_MAGIC[4] = {'C', 'L', 'R', '2'};
+static constexpr int RESULT_RECORD_INTS = 15;
+
+static void packResult(const GameResult &r, int32_t *record)
+{
+	int32_t *p = record;
+	*p++ = r.game;
+	for (int i = 0; i < 2; ++i)
+		*p++ = r.scores[i];
+	for (int i = 0; i < 2; ++i)
+		*p++ = r.passengersTotal[i];
+	for (int i = 0; i < 8; ++i)
+		*p++ = r.scoresByElevators[i];
+	for (int i = 0; i < 2; ++i)
+		*p++ = r.remaining[i];
+}
+
+static void unpackResult(const int32_t *record, GameResult &r)
+{
+	const int32_t *p = record;
+	r.game = *p++;
+	for (int i = 0; i < 2; ++i)
+		r.scores[i] = *p++;
+	for (int i = 0; i < 2; ++i)
+		r.passengersTotal[i] = *p++;
+	for (int i = 0; i < 8; ++i)
+		r.scoresByElevators[i] = *p++;
+	for (int i = 0; i < 2; ++i)
+		r.remaining[i] = *p++;
+}
+
+bool ResultFileHeader::isSameRun(const ResultFileHeader &other) const
+{
+	return left == other.left && right == other.right && shards == other.shards
+		&& games == other.games && seedBase == other.seedBase;
+}
+
+bool ResultFileHeader::operator == (const ResultFileHeader &other) const
+{
+	return isSameRun(other) && shard == other.shard;
+}
+
+std::ostream &operator << (std::ostream &out, const ResultFileHeader &header)
+{
+	return out << header.left << " / " << header.right << " shard " << header.shard << "/" << header.shards
+		<< " games " << header.games << " seed " << header.seedBase;
+}
+
+static void writeString(std::ostream &out, const std::string &s)
+{
+	int32_t size = s.size();
+	out.write((const char *) &size, sizeof(size));
+	out.write(s.data(), size);
+}
+
+static bool readString(std::istream &in, std::string &s)
+{
+	int32_t size;
+	if (!in.read((char *) &size, sizeof(size)) || size < 0 || size > 1024)
+		return false;
+	s.resize(size);
+	return size == 0 || in.read(&s[0], size);
+}
+
+static void writeHeader(std::ostream &out, const ResultFileHeader &header)
+{
+	out.write(RESULT_FILE_MAGIC, 4);
+	int32_t fields[4] = {header.shard, header.shards, header.games, (int32_t) header.seedBase};
+	out.write((const char *) fields, sizeof(fields));
+	writeString(out, header.left);
+	writeString(out, header.right);
+}
+
+static bool readHeader(std::istream &in, ResultFileHeader &header)
+{
+	char magic[4];
+	if (!in.read(magic, 4) || !std::equal(magic, magic + 4, RESULT_FILE_MAGIC))
+		return false;
+
+	int32_t fields[4];
+	if (!in.read((char *) fields, sizeof(fields)))
+		return false;
+	header.shard = fields[0];
+	header.shards = fields[1];
+	header.games = fields[2];
+	header.seedBase = (uint32_t) fields[3];
+	return readString(in, header.left) && readString(in, header.right);
+}
+
+bool readResultFile(const std::string &path, ResultFileHeader &header, std::vector<GameResult> &results)
+{
+	std::ifstream in(path, std::ios::binary);
+	if (!in)
+		return false;
+
+	if (!readHeader(in, header))
+	{
+		std::cerr << "Invalid result file " << path << std::endl;
+		return false;
+	}
+
+	int32_t record[RESULT_RECORD_INTS];
+	while (in.read((char *) record, sizeof(record)))
+	{
+		GameResult result;
+		unpackResult(record, result);
+		results.push_back(result);
+	}
+
+	return true;
+}
+
+bool ResultFileWriter::open(const std::string &path, const ResultFileHeader &header, const std::vector<GameResult> &completed)
+{
+	std::string tmpPath = path + ".tmp";
+	{
+		std::ofstream tmp(tmpPath, std::ios::binary | std::ios::trunc);
+		writeHeader(tmp, header);
+		int32_t record[RESULT_RECORD_INTS];
+		for (const GameResult &result : completed)
+		{
+			packResult(result, record);
+			tmp.write((const char *) record, sizeof(record));
+		}
+
+		if (!tmp)
+		{
+			std::cerr << "Can't write " << tmpPath << std::endl;
+			return false;
+		}
+	}
+
+	if (std::rename(tmpPath.c_str(), path.c_str()))
+	{
+		std::cerr << "Can't rename " << tmpPath << " to " << path << std::endl;
+		return false;
+	}
+
+	out.open(path, std::ios::binary | std::ios::app);
+	return (bool) out;
+}
+
+void ResultFileWriter::append(const GameResult &result)
+{
+	int32_t record[RESULT_RECORD_INTS];
+	packResult(result, record);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	out.write((const char *) record, sizeof(record));
+	out.flush();
+}
+
+void TournamentSummary::add(const GameResult &result)
+{
+	++iterations;
+	totalLeft += result.scores[0];
+	totalRight += result.scores[1];
+	totalLeftRem += result.remaining[0];
+	totalRightRem += result.remaining[1];
+
+	for (int i = 0; i < 8; ++i)
+		scoresByElevator[i] += result.scoresByElevators[i];
+
+	if (result.scores[1] > result.scores[0])
+		++won;
+
+	if (result.scores[1] < result.scores[0])
+		++loss;
+}
+
+void TournamentSummary::print(std::ostream &out) const
+{
+	for (int i = 0; i < 8; ++i)
+	{
+		out << "EL " << i << " - " << scoresByElevator[i] << std::endl;
+	}
+
+	out << "RES: " << ((totalRight + 1) / (totalLeft + 1))
+	<< " " << (totalLeft / iterations) << " " << (totalRight / iterations)
+	<< " rem " << (totalLeftRem / iterations) << " " << (totalRightRem / iterations)
+	<< " W " << ((float) won * 100 / (float) iterations)
+	<< " L " << ((float) loss * 100 / (float) iterations)
+	<< (won > loss && totalRight > totalLeft*1.03 ? " GOOD" : "")
+	<< (won > loss*1.5 && totalRight > totalLeft*1.05 ? "!" : "")
+	<< (won > loss*2 && totalRight > totalLeft*1.1 ? "!" : "")
+	<< (won > loss*4 && totalRight > totalLeft*1.2 ? "!" : "")
+	<< (won > loss*10 && totalRight > totalLeft*1.2 ? "!" : "")
+	<< std::endl;
+}
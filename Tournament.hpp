@@ -0,0 +1,114 @@
+#ifndef TOURNAMENT_HPP
+#define TOURNAMENT_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Strategy.hpp"
+#include "StrategyRegistry.hpp"
+#include "Replay.hpp"
+
+struct GameResult
+{
+	int game = -1;
+	int scores[2] = {};
+	int passengersTotal[2] = {};
+	int scoresByElevators[8] = {};
+	int remaining[2] = {}; // cargo left in the elevators at the end of the game
+};
+
+GameResult makeGameResult(int game, Simulator &sim);
+
+// World seed of game `game` is MATCH_SEED_BASE + game*12345
+static constexpr uint32_t MATCH_SEED_BASE = 251000;
+
+// Game number `game` of compareStrategies: fixed world seed per game, the
+// left strategy's shadow simulator is reseeded per game, the right one is not.
+// recorder, if set, gets the commands of both sides.
+GameResult playMatch(const StrategyFactory &left, const StrategyFactory &right, int game, ReplayRecorder *recorder = nullptr);
+
+struct TournamentOptions
+{
+	int threads = 1;
+	bool affinity = false; // pin worker k to cpu (firstCpu + k) % cpus
+	int firstCpu = 0;
+};
+
+typedef std::function<GameResult (int game)> GameFunction;
+typedef std::function<void (const GameResult &result)> GameCallback;
+
+// Plays games [first, first + count) on options.threads workers. Every worker
+// takes the next game index from an atomic counter and writes only its own
+// result slot, so results[k] always belongs to game first + k.
+// onFinished is called from the worker threads.
+std::vector<GameResult> playGames(int first, int count, const GameFunction &play,
+	const TournamentOptions &options, const GameCallback &onFinished = GameCallback());
+// Same for an arbitrary list of games, results[k] belongs to games[k].
+// Once *stop is set workers take no new games, unplayed results keep game == -1.
+std::vector<GameResult> playGames(const std::vector<int> &games, const GameFunction &play,
+	const TournamentOptions &options, const GameCallback &onFinished = GameCallback(),
+	const std::atomic<bool> *stop = nullptr);
+
+// Games [first, first + count) of shard `shard` out of `shards`
+void getShardRange(int shard, int shards, int games, int &first, int &count);
+
+// What a result file was played for, results of another matchup, game count
+// or seeding must not be mixed in
+struct ResultFileHeader
+{
+	std::string left;
+	std::string right;
+	int shard = 0;
+	int shards = 1;
+	int games = 0;
+	uint32_t seedBase = MATCH_SEED_BASE;
+
+	// Same run, the shard may differ
+	bool isSameRun(const ResultFileHeader &other) const;
+	bool operator == (const ResultFileHeader &other) const;
+};
+
+std::ostream &operator << (std::ostream &out, const ResultFileHeader &header);
+
+// Result file of a shard: "CLR2" magic, the header (int32 shard, shards, games,
+// seedBase, then left and right as int32 length + chars) and fixed-size int32
+// records in host byte order (see GameResult), one appended per finished game.
+// A truncated last record (killed process) is ignored.
+bool readResultFile(const std::string &path, ResultFileHeader &header, std::vector<GameResult> &results);
+
+class ResultFileWriter
+{
+public:
+	// Rewrites the file with the already completed results, drops a broken tail
+	bool open(const std::string &path, const ResultFileHeader &header, const std::vector<GameResult> &completed);
+	// Thread safe, flushed after every record
+	void append(const GameResult &result);
+
+private:
+	std::mutex mutex;
+	std::ofstream out;
+};
+
+// Totals of compareStrategies, right side is the tested strategy.
+// Add results in game order to get the same output for any thread count.
+struct TournamentSummary
+{
+	double totalLeft = 0;
+	double totalRight = 0;
+	double totalLeftRem = 0;
+	double totalRightRem = 0;
+	int iterations = 0;
+	int won = 0;
+	int loss = 0;
+	int scoresByElevator[8] = {};
+
+	void add(const GameResult &result);
+	void print(std::ostream &out) const;
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <atomic>
+
+// Lock-free single producer / single consumer triple buffer. The writer fills
+// getWriteBuffer() and publishes it, the reader takes the newest published
+// slot with update(). Neither side ever waits for the other, old snapshots
+// the reader didn't take are overwritten.
+template <typename T>
+class TripleBuffer
+{
+public:
+	// Writer side
+	T &getWriteBuffer() { return slots[back]; }
+	void publish() { back = middle.exchange(back | FRESH) & INDEX; }
+	// true while the last published slot is not taken by the reader
+	bool hasFresh() const { return middle.load() & FRESH; }
+
+	// Reader side, true if a newer slot was taken
+	bool update()
+	{
+		if (!(middle.load() & FRESH))
+			return false;
+		front = middle.exchange(front) & INDEX;
+		return true;
+	}
+	T &getReadBuffer() { return slots[front]; }
+
+private:
+	static const int INDEX = 3;
+	static const int FRESH = 4;
+
+	T slots[3];
+	std::atomic<int> middle{1};
+	int back = 0;
+	int front = 2;
+};
+
+#endif
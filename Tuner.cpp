@@ -0,0 +1,215 @@
+#include "Tuner.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+struct TunedParam
+{
+	const char *name;
+	int min, max;
+	int &(*get)(StrategyParams &params);
+};
+
+static const TunedParam TUNED_PARAMS[] = {
+	{"fullWait", 300, 900, [](StrategyParams &p) -> int & { return p.fullWait; }},
+	{"waitPerPassenger", 20, 100, [](StrategyParams &p) -> int & { return p.waitPerPassenger; }},
+	{"waitFreePassengers", 5, 14, [](StrategyParams &p) -> int & { return p.waitFreePassengers; }},
+	{"cargoTicksCap", 600, 1800, [](StrategyParams &p) -> int & { return p.cargoTicksCap; }},
+	{"horizonBase", 200, 700, [](StrategyParams &p) -> int & { return p.horizonBase; }},
+	{"horizonPerElevator", 0, 100, [](StrategyParams &p) -> int & { return p.horizonPerElevator; }},
+	{"lowerElevatorPenalty", 0, 400, [](StrategyParams &p) -> int & { return p.lowerElevatorPenalty; }},
+	{"groundFloorPenalty", 0, 300, [](StrategyParams &p) -> int & { return p.groundFloorPenalty; }},
+	{"firstMoveMinDest0", 0, 8, [](StrategyParams &p) -> int & { return p.firstMoveMinDest[0]; }},
+	{"firstMoveMinDest1", 0, 8, [](StrategyParams &p) -> int & { return p.firstMoveMinDest[1]; }},
+	{"firstMoveMinDest2", 0, 8, [](StrategyParams &p) -> int & { return p.firstMoveMinDest[2]; }},
+	{"firstMoveMinDest3", 0, 8, [](StrategyParams &p) -> int & { return p.firstMoveMinDest[3]; }},
+	{"lowValueLimit1", 0, 5, [](StrategyParams &p) -> int & { return p.lowValueLimit1; }},
+	{"lowValue1", 0, 60, [](StrategyParams &p) -> int & { return p.lowValue1; }},
+	{"lowValueLimit2", 0, 8, [](StrategyParams &p) -> int & { return p.lowValueLimit2; }},
+	{"lowValue2", 0, 50, [](StrategyParams &p) -> int & { return p.lowValue2; }},
+};
+
+std::string formatParams(const StrategyParams &params)
+{
+	StrategyParams copy = params;
+	std::ostringstream str;
+	for (const TunedParam &param : TUNED_PARAMS)
+	{
+		if (str.tellp() > 0)
+			str << ",";
+		str << param.name << "=" << param.get(copy);
+	}
+	return str.str();
+}
+
+bool parseParams(const std::string &str, StrategyParams &params)
+{
+	std::istringstream in(str);
+	std::string item;
+	while (std::getline(in, item, ','))
+	{
+		size_t eq = item.find('=');
+		if (eq == std::string::npos)
+			return false;
+
+		std::string name = item.substr(0, eq);
+		auto it = std::find_if(std::begin(TUNED_PARAMS), std::end(TUNED_PARAMS),
+			[&](const TunedParam &param) { return name == param.name; });
+		if (it == std::end(TUNED_PARAMS))
+			return false;
+
+		it->get(params) = atoi(item.c_str() + eq + 1);
+	}
+	return true;
+}
+
+namespace
+{
+	struct Candidate
+	{
+		StrategyParams params;
+		bool alive = true;
+		std::vector<double> ratios; // log((right + 1) / (left + 1)) per seed
+		int wins = 0;
+		int losses = 0;
+	};
+
+	// Mean and standard error of the paired differences a - b over the common seeds
+	void pairedDiff(const Candidate &a, const Candidate &b, double &mean, double &error)
+	{
+		size_t n = std::min(a.ratios.size(), b.ratios.size());
+		double sum = 0, sum2 = 0;
+		for (size_t i = 0; i < n; ++i)
+		{
+			double d = a.ratios[i] - b.ratios[i];
+			sum += d;
+			sum2 += d * d;
+		}
+		mean = n ? sum / n : 0.0;
+		error = n > 1 ? std::sqrt(std::max(0.0, (sum2 - n * mean * mean) / (n - 1)) / n) : 0.0;
+	}
+
+	double meanRatio(const Candidate &candidate)
+	{
+		double sum = 0;
+		for (double x : candidate.ratios)
+			sum += x;
+		return candidate.ratios.empty() ? 0.0 : sum / candidate.ratios.size();
+	}
+}
+
+void runTuner(const StrategyRegistry &registry, const TunerOptions &tuner, const TournamentOptions &options)
+{
+	std::mt19937 random(tuner.seed);
+	std::normal_distribution<double> normal;
+	std::vector<Candidate> candidates(std::max(1, tuner.candidates));
+	for (size_t c = 1; c < candidates.size(); ++c)
+	{
+		for (const TunedParam &param : TUNED_PARAMS)
+		{
+			if (random() % 2)
+				continue;
+
+			int &value = param.get(candidates[c].params);
+			value += (int) std::lround(normal(random) * (param.max - param.min) * tuner.spread);
+			value = std::max(param.min, std::min(param.max, value));
+		}
+	}
+
+	const StrategyFactory &opponent = registry.get(tuner.opponent);
+	std::vector<StrategyFactory> factories;
+	for (const Candidate &candidate : candidates)
+	{
+		StrategyParams params = candidate.params;
+		factories.push_back([params](Side side, uint32_t seed) {
+			SimulatingStrategy<MyStrategy> *strategy = new SimulatingStrategy<MyStrategy>(side, seed);
+			strategy->strategy.setParams(params);
+			return std::unique_ptr<IStrategy>(strategy);
+		});
+	}
+
+	int played = 0;
+	while (played < tuner.maxGames)
+	{
+		int block = std::min(tuner.blockGames, tuner.maxGames - played);
+		std::vector<int> jobs;
+		for (size_t c = 0; c < candidates.size(); ++c)
+		{
+			if (!candidates[c].alive)
+				continue;
+			for (int i = played; i < played + block; ++i)
+				jobs.push_back(c * tuner.maxGames + i);
+		}
+
+		std::vector<GameResult> results = playGames(jobs, [&](int job) {
+			GameResult result = playMatch(opponent, factories[job / tuner.maxGames], job % tuner.maxGames);
+			result.game = job;
+			return result;
+		}, options);
+
+		// jobs are in (candidate, seed) order, so ratios stay in seed order
+		for (const GameResult &result : results)
+		{
+			Candidate &candidate = candidates[result.game / tuner.maxGames];
+			candidate.ratios.push_back(std::log((result.scores[1] + 1.0) / (result.scores[0] + 1.0)));
+			candidate.wins += result.scores[1] > result.scores[0];
+			candidate.losses += result.scores[1] < result.scores[0];
+		}
+		played += block;
+
+		size_t best = 0;
+		for (size_t c = 0; c < candidates.size(); ++c)
+		{
+			if (candidates[c].alive && meanRatio(candidates[c]) > meanRatio(candidates[best]))
+				best = c;
+		}
+
+		int alive = 0;
+		for (size_t c = 1; c < candidates.size(); ++c)
+		{
+			if (!candidates[c].alive || c == best || played < tuner.minGames)
+			{
+				alive += candidates[c].alive;
+				continue;
+			}
+
+			double mean, error;
+			pairedDiff(candidates[c], candidates[best], mean, error);
+			if (mean + tuner.z * error < 0.0)
+				candidates[c].alive = false;
+			alive += candidates[c].alive;
+		}
+
+		std::cout << "TUNE games " << played << " alive " << (alive + 1) << " best " << best
+			<< " ratio " << std::exp(meanRatio(candidates[best])) << std::endl;
+
+		if (alive == 0)
+			break;
+	}
+
+	std::vector<size_t> order;
+	for (size_t c = 0; c < candidates.size(); ++c)
+		order.push_back(c);
+	std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+		if (candidates[a].ratios.size() != candidates[b].ratios.size())
+			return candidates[a].ratios.size() > candidates[b].ratios.size();
+		return meanRatio(candidates[a]) > meanRatio(candidates[b]);
+	});
+
+	// Ratio to the defaults with a 95% interval, on the seeds both played
+	for (size_t c : order)
+	{
+		const Candidate &candidate = candidates[c];
+		double mean, error;
+		pairedDiff(candidate, candidates[0], mean, error);
+		int n = candidate.ratios.size();
+		std::cout << "CANDIDATE " << c << (candidate.alive ? "" : " dropped") << " games " << n
+			<< " RES: " << std::exp(meanRatio(candidate))
+			<< " W " << ((float) candidate.wins * 100 / (float) n)
+			<< " L " << ((float) candidate.losses * 100 / (float) n)
+			<< " vs default " << std::exp(mean) << " [" << std::exp(mean - 1.96 * error) << ", " << std::exp(mean + 1.96 * error) << "]"
+			<< "\n\t" << formatParams(candidate.params) << std::endl;
+	}
+}
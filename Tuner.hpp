@@ -0,0 +1,33 @@
+#ifndef TUNER_HPP
+#define TUNER_HPP
+
+#include <string>
+#include "mystrategy.hpp"
+#include "StrategyRegistry.hpp"
+#include "Tournament.hpp"
+
+// Racing of StrategyParams candidates: candidate 0 is the current defaults,
+// the rest are random perturbations of them. All candidates play the same
+// seeds block by block against a fixed opponent, a candidate is dropped once
+// its paired log score ratio to the leader is worse with the given confidence.
+// The defaults are never dropped and serve as the control.
+struct TunerOptions
+{
+	std::string opponent = "strat4932";
+	int candidates = 16;
+	int maxGames = 100;       // seeds per candidate at most
+	int blockGames = 10;      // seeds added per round
+	int minGames = 20;        // no eliminations before that
+	double z = 1.96;          // elimination threshold in standard errors
+	double spread = 0.15;     // perturbation sd as a part of the parameter range
+	uint32_t seed = 1;
+};
+
+// "name=value" of every tuned parameter, comma separated
+std::string formatParams(const StrategyParams &params);
+// Applies "name=value,..." on top of params, false on unknown names
+bool parseParams(const std::string &str, StrategyParams &params);
+
+void runTuner(const StrategyRegistry &registry, const TunerOptions &tuner, const TournamentOptions &options);
+
+#endif
@@ -0,0 +1,204 @@
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Strategy.hpp"
+#include "mystrategy.hpp"
+#include "OpponentModel.hpp"
+#include "TickProfiler.hpp"
+
+// Headless micro-benchmarks of the simulator and planner kernels.
+// Every kernel prints one JSON line, e.g.
+// {"kernel":"sim_step","state":"mid","tick":3600,"iterations":...,"ns_per_op":...,"ops_per_sec":...}
+
+typedef std::chrono::steady_clock Clock;
+
+struct GameState
+{
+	const char *name;
+	int tick;
+	Simulator sim;
+	MyStrategy strategy;
+
+	GameState(const char *name, int tick) : name(name), tick(tick), strategy(Side::RIGHT) {}
+};
+
+struct BenchOptions
+{
+	double minTimeMs = 300.0;
+	int seed = 0;
+	std::string filter;
+};
+
+static volatile double g_sink = 0.0;
+
+// Same seeding as compareStrategies() game number seed
+static std::vector<GameState> makeStates(int seed)
+{
+	std::vector<GameState> states;
+	states.emplace_back("early", 600);
+	states.emplace_back("mid", 3600);
+	states.emplace_back("late", 6600);
+
+	Simulator simulator;
+	simulator.random.m_w = 251000 + seed*12345;
+	MyStrategy stratLeft(Side::LEFT);
+	stratLeft.sim.random.m_w = 30000 + seed*89741;
+	MyStrategy stratRight(Side::RIGHT);
+
+	for (GameState &state : states)
+	{
+		while (simulator.tick < state.tick)
+		{
+			stratLeft.makeMove(simulator);
+			stratRight.makeMove(simulator);
+			simulator.step();
+		}
+
+		state.sim = simulator;
+		state.strategy = stratRight;
+	}
+
+	return states;
+}
+
+// Runs batches of `opsPerBatch` operations until minTimeMs elapsed; setup is excluded from timing
+static void runKernel(const BenchOptions &options, const char *kernel, const GameState &state, int opsPerBatch,
+	const char *extraName, double extraPerOp,
+	const std::function<void()> &setup, const std::function<void()> &body)
+{
+	std::string fullName = std::string(kernel) + "/" + state.name;
+	if (!options.filter.empty() && fullName.find(options.filter) == std::string::npos)
+		return;
+
+	LatencyHistogram histogram;
+	uint64_t totalNs = 0;
+	uint64_t iterations = 0;
+	while (totalNs < options.minTimeMs * 1e6 || iterations == 0)
+	{
+		setup();
+		Clock::time_point start = Clock::now();
+		for (int i = 0; i < opsPerBatch; ++i)
+			body();
+		uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+
+		totalNs += ns;
+		iterations += opsPerBatch;
+		histogram.record(ns / opsPerBatch);
+	}
+
+	double nsPerOp = (double) totalNs / iterations;
+	std::cout << "{\"kernel\":\"" << kernel << "\",\"state\":\"" << state.name << "\",\"tick\":" << state.tick
+		<< ",\"iterations\":" << iterations
+		<< ",\"ns_per_op\":" << nsPerOp
+		<< ",\"p50_ns\":" << histogram.percentile(0.5)
+		<< ",\"max_ns\":" << histogram.maxValue
+		<< ",\"ops_per_sec\":" << 1e9 / nsPerOp;
+	if (extraName)
+		std::cout << ",\"" << extraName << "\":" << extraPerOp * 1e9 / nsPerOp;
+	std::cout << "}" << std::endl;
+}
+
+static MyElevator &firstElevator(Simulator &sim, Side side)
+{
+	for (MyElevator &elevator : sim.elevators)
+	{
+		if (elevator.side == side)
+			return elevator;
+	}
+	return sim.elevators[0];
+}
+
+static void runBenchmarks(const BenchOptions &options)
+{
+	std::vector<GameState> states = makeStates(options.seed);
+
+	for (GameState &state : states)
+	{
+		const int STEP_TICKS = 100;
+		Simulator sim;
+		runKernel(options, "sim_step", state, STEP_TICKS, "ticks_per_sec", 1.0,
+			[&]() { sim = state.sim; },
+			[&]() { sim.step(); });
+
+		runKernel(options, "mystrategy_copy", state, 1, nullptr, 0.0,
+			[]() {},
+			[&]() {
+				MyStrategy copy = state.strategy;
+				g_sink = g_sink + copy.sim.tick;
+			});
+
+		// Rollouts the pruning leaves, the same on every run from this state
+		MyStrategy strategy = state.strategy;
+		int64_t evaluated = strategy.pruneStats.evaluated;
+		strategy.strategy1.recalcDestinationBeforeDoorsClose(strategy.sim, firstElevator(strategy.sim, strategy.side), &strategy);
+		evaluated = strategy.pruneStats.evaluated - evaluated;
+		runKernel(options, "recalc_destination", state, 1, "rollouts_per_sec", (double) evaluated,
+			[&]() { strategy = state.strategy; },
+			[&]() {
+				MyElevator &elevator = firstElevator(strategy.sim, strategy.side);
+				strategy.strategy1.recalcDestinationBeforeDoorsClose(strategy.sim, elevator, &strategy);
+			});
+
+		// One rollout tick of each rollout opponent model, kernel name by model
+		for (int type = 0; type < (int) OpponentModelType::COUNT; ++type)
+		{
+			std::string kernel = std::string("rollout_tick_") + getOpponentModelName((OpponentModelType) type);
+			std::unique_ptr<DestinationRollout> rollout;
+			runKernel(options, kernel.c_str(), state, STEP_TICKS, "ticks_per_sec", 1.0,
+				[&]() {
+					MyStrategy copy = state.strategy;
+					copy.rolloutOpponent = (OpponentModelType) type;
+					rollout.reset(new DestinationRollout(copy));
+					rollout->copy.strategy1.doPredictions = false;
+					rollout->copy.strategy2.doPredictions = false;
+					rollout->copy.strategy3.doPredictions = false;
+					rollout->copy.strategy4.doPredictions = false;
+					rollout->length = STEP_TICKS;
+				},
+				[&]() { rollout->advance(1); });
+		}
+
+		runKernel(options, "invite_passengers", state, 100, nullptr, 0.0,
+			[&]() { strategy = state.strategy; },
+			[&]() {
+				MyElevator &elevator = firstElevator(strategy.sim, strategy.side);
+				g_sink = g_sink + strategy.strategy1.invitePassengers(strategy.sim, elevator);
+			});
+
+		runKernel(options, "cargo_value2", state, 1000, nullptr, 0.0,
+			[&]() { strategy = state.strategy; },
+			[&]() {
+				for (MyElevator &elevator : strategy.sim.elevators)
+					g_sink = g_sink + strategy.sim.getCargoValue2(elevator).points;
+			});
+
+		runKernel(options, "synchronize_with", state, 100, nullptr, 0.0,
+			[&]() { strategy = state.strategy; },
+			[&]() { strategy.sim.synchronizeWith(state.sim); });
+	}
+}
+
+int main(int argc, char **argv)
+{
+	BenchOptions options;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!strcmp(argv[i], "--min-time") && i + 1 < argc)
+			options.minTimeMs = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+			options.seed = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--filter") && i + 1 < argc)
+			options.filter = argv[++i];
+		else
+		{
+			std::cerr << "Usage: " << argv[0] << " [--min-time ms] [--seed n] [--filter kernel/state]" << std::endl;
+			return 1;
+		}
+	}
+
+	runBenchmarks(options);
+	return 0;
+}
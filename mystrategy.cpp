@@ -1,6 +1,9 @@
 
 #ifndef HEADER_OLNY_INLINE
 #include "mystrategy.hpp"
+#include "Evaluator.hpp"
+#include "OpponentModel.hpp"
+#include "Planner.hpp"
 #endif
 #include <cmath>
 #include <algorithm>
@@ -80,10 +83,17 @@ HEADER_OLNY_INLINE MyStrategy::MyStrategy(Side side) : side(side)
 	strategy3.side = side;
 	strategy4.side = side;
 	
-	strategy1.firstMoveMinDest = 6;
-	strategy2.firstMoveMinDest = 5;
-	strategy3.firstMoveMinDest = 3;
-	strategy4.firstMoveMinDest = 2;
+	setParams(StrategyParams());
+}
+
+HEADER_OLNY_INLINE void MyStrategy::setParams(const StrategyParams &params)
+{
+	ElevatorStrategyUpDown *strategies[] = {&strategy1, &strategy2, &strategy3, &strategy4};
+	for (int i = 0; i < 4; ++i)
+	{
+		strategies[i]->params = params;
+		strategies[i]->firstMoveMinDest = params.firstMoveMinDest[i];
+	}
 }
 
 HEADER_OLNY_INLINE MyStrategy::~MyStrategy()
@@ -122,79 +132,86 @@ HEADER_OLNY_INLINE void MyStrategy::makeMove(Simulator &inputSim)
     sim.step();
 }
 
+HEADER_OLNY_INLINE ElevatorStrategyUpDown &MyStrategy::getElevatorStrategy(int ind)
+{
+	ElevatorStrategyUpDown *strategies[] = {&strategy1, &strategy2, &strategy3, &strategy4};
+	return *strategies[ind];
+}
+
+HEADER_OLNY_INLINE void MyStrategy::setPlannerMode(PlannerMode mode)
+{
+	if (mode == PlannerMode::SPECULATIVE)
+		planner.planner.reset(new SpeculativePlanner());
+	else if (mode == PlannerMode::SLICED)
+		planner.planner.reset(new SlicedPlanner());
+	else if (mode == PlannerMode::JOINT)
+		planner.planner.reset(new JointPlanner());
+	else if (mode == PlannerMode::MCTS)
+		planner.planner.reset(new MctsPlanner());
+	else if (mode == PlannerMode::BEAM)
+		planner.planner.reset(new BeamPlanner());
+	else
+		planner.planner.reset();
+}
+
+HEADER_OLNY_INLINE void MyStrategy::setEvaluator(const StateEvaluator *evaluator)
+{
+	this->evaluator = evaluator;
+	for (ElevatorStrategyUpDown *strategy : {&strategy1, &strategy2, &strategy3, &strategy4})
+		strategy->evaluatorHorizon = evaluator ? evaluator->horizon : 0;
+}
+
+HEADER_OLNY_INLINE void ElevatorStrategyUpDown::planDestination(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
+{
+	ClosingPlanner *planner = strategy->getPlanner();
+	if (elevator.closing_or_opening_ticks == 98)
+	{
+		if (planner)
+			planner->commit(sim, elevator, strategy);
+		else
+			recalcDestinationBeforeDoorsClose(sim, elevator, strategy);
+	}
+	else if (planner)
+	{
+		planner->speculate(sim, elevator, strategy);
+	}
+}
+
 HEADER_OLNY_INLINE void ElevatorStrategyUpDown::recalcDestinationBeforeDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
 {
 	int res = -100000;
 	int targetFloor = -1;
 	
-	Side enemySide = inverseSide(strategy->side);
-	int maxTicks = 7200 - sim.tick - 2;
-	float coef = 1.0;
-	if (maxTicks < 1500)
-		coef = ((float)maxTicks - 300.0f) / 1200.0f;
-	
+	int order[LEVELS_COUNT];
+	int bounds[LEVELS_COUNT] = {};
 	for (int i = 0; i < LEVELS_COUNT; ++i)
+		order[i] = i;
+	if (params.pruneBound >= 0)
+	{
+		getDestinationBounds(sim, elevator, getRolloutLength(sim, elevator, 0), bounds);
+		std::stable_sort(order, order + LEVELS_COUNT, [&bounds](int a, int b) { return bounds[a] > bounds[b]; });
+	}
+	
+	// Heuristic cut, off by default: floors with at most pruneBound optimistic
+	// points aren't rolled out once one floor was. The bound isn't in the
+	// units of evaluateDestination, so it can't be compared with res and does
+	// change decisions (pruneBound 20 turns arena game 3 from 8700-8220 into
+	// 8210-8560)
+	bool anyEvaluated = false;
+	for (int i : order)
 	{
 		if (i != elevator.getFloor())
 		{
-			MyStrategy copy = *strategy;
-			copy.strategy1.doPredictions = false;
-			copy.strategy2.doPredictions = false;
-			copy.strategy3.doPredictions = false;
-			copy.strategy4.doPredictions = false;
-			
-			MyElevator &el = copy.sim.elevators[elevator.id];
-			el.go_to_floor = i;
-			
-			int tick = 0;
-			for (; tick < std::min(400 + elevator.ind * 40, maxTicks); ++tick)
+			if (anyEvaluated && bounds[i] <= params.pruneBound)
 			{
-				//makeMoveSimple(enemySide, copy.sim);
-				copy.makeMove();
-				copy.sim.step();
+				++strategy->pruneStats.pruned;
+				continue;
 			}
 			
-			int points;
-			
-			
-			int valLeft, valRight;
-			valLeft = copy.sim.scores[0] + copy.sim.passengersTotal[0]*1 + copy.sim.totalCargoValue2(Side::LEFT).points*0.5 * coef;
-			valRight = copy.sim.scores[1] + copy.sim.passengersTotal[1]*1 + copy.sim.totalCargoValue2(Side::RIGHT).points*0.5 * coef;
-			
-			if (copy.side == Side::LEFT)
-				points = valLeft - valRight;
-			else
-				points = valRight - valLeft;
-			
-			
-			int passGone = 0;
-			for (int id : elevator.passengers)
-			{
-				if (!el.passengers.count(id))
-				{
-					++passGone;
-				}
-			}
-			
-			if (passGone < 10 && i == 0)
-				points -= 100;
-			
-			
-			if (i == elevator.next_floor)
-				++points;
-			
-			for (MyElevator &e : sim.elevators)
-			{
-				if (e.id != elevator.id && e.state == EState::MOVING && e.next_floor == i)
-				{
-					if (e.side == elevator.side && e.ind < elevator.ind)
-					{
-						points -= 200;
-					}
-				}
-			}
-			
-			if (points > res)
+			int points = evaluateDestination(sim, elevator, strategy, i);
+			++strategy->pruneStats.evaluated;
+			anyEvaluated = true;
+			if (points > res || (points == res && i < targetFloor))
 			{
 				res = points;
 				targetFloor = i;
@@ -210,3 +227,150 @@ HEADER_OLNY_INLINE void ElevatorStrategyUpDown::recalcDestinationBeforeDoorsClos
 	}
 }
 
+HEADER_OLNY_INLINE int ElevatorStrategyUpDown::evaluateDestination(Simulator &sim, const MyElevator &elevator, MyStrategy *strategy, int floor, int delay) const
+{
+	DestinationRollout rollout(*strategy);
+	startRollout(rollout, sim, elevator, floor, delay);
+	rollout.advance(rollout.length);
+	return scoreRollout(rollout, sim, elevator);
+}
+
+HEADER_OLNY_INLINE void ElevatorStrategyUpDown::startRollout(DestinationRollout &rollout, Simulator &sim, const MyElevator &elevator, int floor, int delay) const
+{
+	rollout.coef = getRolloutCoef(sim, delay);
+	
+	MyStrategy &copy = rollout.copy;
+	copy.strategy1.doPredictions = false;
+	copy.strategy2.doPredictions = false;
+	copy.strategy3.doPredictions = false;
+	copy.strategy4.doPredictions = false;
+	
+	copy.sim.elevators[elevator.id].go_to_floor = floor;
+	rollout.floor = floor;
+	rollout.tick = 0;
+	rollout.length = getRolloutLength(sim, elevator, delay);
+}
+
+HEADER_OLNY_INLINE float ElevatorStrategyUpDown::getRolloutCoef(const Simulator &sim, int delay) const
+{
+	int maxTicks = 7200 - sim.tick - delay - 2;
+	if (maxTicks < 1500)
+		return ((float)maxTicks - 300.0f) / 1200.0f;
+	return 1.0f;
+}
+
+HEADER_OLNY_INLINE int ElevatorStrategyUpDown::getRolloutLength(const Simulator &sim, const MyElevator &elevator, int delay) const
+{
+	int maxTicks = 7200 - sim.tick - delay - 2;
+	int horizon = evaluatorHorizon ? evaluatorHorizon : params.horizonBase + elevator.ind * params.horizonPerElevator;
+	return delay + std::min(horizon, maxTicks);
+}
+
+HEADER_OLNY_INLINE void ElevatorStrategyUpDown::getDestinationBounds(Simulator &sim, const MyElevator &elevator, int horizon, int bounds[LEVELS_COUNT]) const
+{
+	for (int i = 0; i < LEVELS_COUNT; ++i)
+		bounds[i] = 0;
+	
+	for (int id : elevator.passengers)
+	{
+		MyPassenger &passenger = sim.passengers[id];
+		bounds[passenger.dest_floor] += passenger.getValue(side);
+	}
+	
+	for (std::pair<const int, MyPassenger> &passengerEntry : sim.passengers)
+	{
+		MyPassenger &passenger = passengerEntry.second;
+		if (passenger.state == PState::WAITING_FOR_ELEVATOR || passenger.state == PState::RETURNING)
+			bounds[passenger.getFloor()] += passenger.getValue(side);
+	}
+	
+	for (auto && p = sim.outPassengers.begin(); p != sim.outPassengers.upper_bound(sim.tick + horizon); ++p)
+	{
+		const MyPassenger &passenger = p->second;
+		int value = std::abs(passenger.getNextDestFloor() - passenger.getFloor()) * 10;
+		if (passenger.side != side)
+			value *= 2;
+		bounds[passenger.getFloor()] += value;
+	}
+}
+
+HEADER_OLNY_INLINE DestinationRollout::DestinationRollout(const MyStrategy &strategy) : copy(strategy)
+{
+	opponent = createOpponentModel(copy.rolloutOpponent, inverseSide(copy.side), copy.getParams());
+}
+
+HEADER_OLNY_INLINE DestinationRollout::~DestinationRollout()
+{
+}
+
+HEADER_OLNY_INLINE int DestinationRollout::advance(int ticks)
+{
+	int count = std::max(0, std::min(ticks, length - tick));
+	for (int i = 0; i < count; ++i)
+	{
+		if (opponent)
+			opponent->makeMove(copy.sim);
+		copy.makeMove();
+		copy.sim.step();
+	}
+	tick += count;
+	return count;
+}
+
+HEADER_OLNY_INLINE int ElevatorStrategyUpDown::scoreRollout(DestinationRollout &rollout, Simulator &sim, const MyElevator &elevator) const
+{
+	return getRolloutValue(rollout.copy, rollout.coef) + getFloorAdjustment(rollout.copy, sim, elevator, rollout.floor);
+}
+
+HEADER_OLNY_INLINE int ElevatorStrategyUpDown::getRolloutValue(MyStrategy &copy, float coef) const
+{
+	if (copy.evaluator)
+		return (int) copy.evaluator->evaluate(copy.sim, copy.side, coef);
+	
+	int points;
+	int valLeft, valRight;
+	valLeft = copy.sim.scores[0] + copy.sim.passengersTotal[0]*1 + copy.sim.totalCargoValue2(Side::LEFT).points*0.5 * coef;
+	valRight = copy.sim.scores[1] + copy.sim.passengersTotal[1]*1 + copy.sim.totalCargoValue2(Side::RIGHT).points*0.5 * coef;
+	
+	if (copy.side == Side::LEFT)
+		points = valLeft - valRight;
+	else
+		points = valRight - valLeft;
+	return points;
+}
+
+HEADER_OLNY_INLINE int ElevatorStrategyUpDown::getFloorAdjustment(MyStrategy &copy, Simulator &sim, const MyElevator &elevator, int floor) const
+{
+	MyElevator &el = copy.sim.elevators[elevator.id];
+	int points = 0;
+	
+	int passGone = 0;
+	for (int id : elevator.passengers)
+	{
+		if (!el.passengers.count(id))
+		{
+			++passGone;
+		}
+	}
+	
+	if (passGone < 10 && floor == 0)
+		points -= params.groundFloorPenalty;
+	
+	
+	if (floor == elevator.next_floor)
+		++points;
+	
+	for (MyElevator &e : sim.elevators)
+	{
+		if (e.id != elevator.id && e.state == EState::MOVING && e.next_floor == floor)
+		{
+			if (e.side == elevator.side && e.ind < elevator.ind)
+			{
+				points -= params.lowerElevatorPenalty;
+			}
+		}
+	}
+	
+	return points;
+}
+
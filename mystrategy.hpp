@@ -6,8 +6,10 @@
 #endif
 
 #include <bitset>
+#include <cstdint>
 #include <iostream>
 #include <map>
+#include <memory>
 
 enum class Direction {
     UP, DOWN
@@ -16,7 +18,64 @@ enum class Direction {
 int getNearestToLevelDestination(Simulator &sim, MyElevator& elevator, int level);
 int getNearestToLevelDestinationNoRand(Simulator &sim, MyElevator& elevator, int level);
 
+// Hand-tuned constants of ElevatorStrategyUpDown, the defaults are the best
+// values found so far (see the RES comments next to their uses)
+struct StrategyParams
+{
+	int fullWait = 630;                 // max ticks to wait for passengers on a floor
+	int waitPerPassenger = 50;          // wait shorter by this for each passenger over waitFreePassengers
+	int waitFreePassengers = 9;
+	int cargoTicksCap = 1200;           // cap of the cargo delivery time reserved at the end of the game
+	int horizonBase = 400;              // rollout length before the doors close, ticks
+	int horizonPerElevator = 40;        // + per elevator index
+	int lowerElevatorPenalty = 200;     // floor is already the target of our lower elevator
+	int groundFloorPenalty = 100;       // going down to 0 with less than 10 passengers leaving
+	int firstMoveMinDest[4] = {6, 5, 3, 2}; // per elevator, first move takes only passengers above it
+	int lowValueLimit1 = 2;             // with <= lowValueLimit1 free places skip passengers cheaper than lowValue1
+	int lowValue1 = 30;
+	int lowValueLimit2 = 4;
+	int lowValue2 = 20;
+	int pruneBound = -1;                // skip floors with at most this getDestinationBounds, -1 - evaluate all
+};
+
+enum class PlannerMode
+{
+	SYNC,        // rollouts on closing tick 98
+	SPECULATIVE, // rollouts on a worker thread during CLOSING, see Planner.hpp
+	SLICED,      // rollouts advanced by a fixed number of ticks per CLOSING tick
+	JOINT,       // elevators closing close together choose their floors together
+	MCTS,        // tree search over the next closing decisions of each elevator
+	BEAM         // analytic beam search over multi-stop plans, the best simulated
+};
+
+class ClosingPlanner;
+
+// Enemy policy in the rollouts of the closing planners, see OpponentModel.hpp
+enum class OpponentModelType
+{
+	IDLE,     // no commands, the enemy elevators stand still
+	SWEEPER,
+	MIRROR,
+	COUNT
+};
+
+class OpponentModel;
+struct StateEvaluator;
+
+// Owns the planner of the real strategy. Copies of MyStrategy are rollouts
+// and snapshots, they don't get one.
+struct PlannerHandle
+{
+	std::unique_ptr<ClosingPlanner> planner;
+
+	PlannerHandle();
+	PlannerHandle(const PlannerHandle &);
+	PlannerHandle &operator = (const PlannerHandle &) { return *this; }
+	~PlannerHandle();
+};
+
 class MyStrategy;
+struct DestinationRollout;
 struct ElevatorStrategyUpDown
 {
 	Side side;
@@ -24,6 +83,8 @@ struct ElevatorStrategyUpDown
 	int dirChanges = 0;
 	int firstMoveMinDest = 0;
 	bool doPredictions = true;
+	StrategyParams params;
+	int evaluatorHorizon = 0;           // rollout length with a StateEvaluator, 0 - params horizon
 	
 	void makeMove(Simulator &sim, MyElevator &elevator, MyStrategy *strategy)
 	{
@@ -40,9 +101,9 @@ struct ElevatorStrategyUpDown
 		else if (dir == Direction::DOWN && elevator.getFloor() == 0)
 			dir = Direction::UP;
 		
-		if (doPredictions && elevator.state == EState::CLOSING && elevator.closing_or_opening_ticks == 98)
+		if (doPredictions && elevator.state == EState::CLOSING && elevator.closing_or_opening_ticks <= 98)
 		{
-			recalcDestinationBeforeDoorsClose(sim, elevator, strategy);
+			planDestination(sim, elevator, strategy);
 			return;
 		}
 		
@@ -90,9 +151,9 @@ struct ElevatorStrategyUpDown
 				//int maxWait = 300 - std::max(0, (int) (elevator.passengers.size()) - 12) * 25;
 				int maxWait;
 				if (elevator.time_on_the_floor_with_opened_doors < 40)
-					maxWait = 630;
+					maxWait = params.fullWait;
 				else
-					maxWait = 630 - std::max(0, (int) (elevator.passengers.size()) - 9) * 50;
+					maxWait = params.fullWait - std::max(0, (int) (elevator.passengers.size()) - params.waitFreePassengers) * params.waitPerPassenger;
 				
 				// 600 7*50 RES: 1.06206 10375.2 11019.1 rem 817.7 1285.5 W 72 L 28 GOOD!
 				// 600 8 50 RES: 1.07105 10244.1 10971.9 rem 833.9 1335.4 W 75 L 24 GOOD!
@@ -105,7 +166,7 @@ struct ElevatorStrategyUpDown
 				// 630 9 60 RES: 1.07513 10215.9 10983.4 rem 830 1335 W 78 L 21 GOOD!
 				// 10 50 RES: 1.05791 10207.7 10798.8 rem 832.3 1418.2 W 75 L 25 GOOD!
 				
-				int ticksToWait = std::min(std::max(0, 7200 - sim.tick - std::min(1200, value.ticks)), maxWait);
+				int ticksToWait = std::min(std::max(0, 7200 - sim.tick - std::min(params.cargoTicksCap, value.ticks)), maxWait);
 				
 				// 1300 RES: 1.08322 10153.2 10998.2 rem 900 1232.8 W 83 L 16 GOOD!
 				// 1200 RES: 1.08367 10136.8 10984.9 rem 890.4 1263.6 W 84 L 15 GOOD!
@@ -168,7 +229,24 @@ struct ElevatorStrategyUpDown
 		}
 	}
 	
+	// Chooses go_to_floor on closing tick 98, in the background since the doors started closing if strategy has a planner
+	void planDestination(Simulator &sim, MyElevator &elevator, MyStrategy *strategy);
 	void recalcDestinationBeforeDoorsClose(Simulator &sim, MyElevator &elevator, MyStrategy *strategy);
+	// Rollout score of sending the closing elevator to floor, delay - ticks left
+	// until closing tick 98, the rollout ends where it would end from there
+	int evaluateDestination(Simulator &sim, const MyElevator &elevator, MyStrategy *strategy, int floor, int delay = 0) const;
+	// evaluateDestination in steps: start, DestinationRollout::advance, score
+	void startRollout(DestinationRollout &rollout, Simulator &sim, const MyElevator &elevator, int floor, int delay) const;
+	int scoreRollout(DestinationRollout &rollout, Simulator &sim, const MyElevator &elevator) const;
+	// scoreRollout = our lead at the end of the rollout + penalties of the elevator's floor choice
+	int getRolloutValue(MyStrategy &copy, float coef) const;
+	int getFloorAdjustment(MyStrategy &copy, Simulator &sim, const MyElevator &elevator, int floor) const;
+	int getRolloutLength(const Simulator &sim, const MyElevator &elevator, int delay) const;
+	// Weight of the cargo left at the end of a rollout, less near the end of the game
+	float getRolloutCoef(const Simulator &sim, int delay) const;
+	// Optimistic points of stopping on each floor first: cargo to it, passengers
+	// waiting on it and out passengers coming out on it within horizon ticks
+	void getDestinationBounds(Simulator &sim, const MyElevator &elevator, int horizon, int bounds[LEVELS_COUNT]) const;
 	
 	void goToFloor(MyElevator &elevator, int go_to_floor)
 	{
@@ -249,7 +327,7 @@ struct ElevatorStrategyUpDown
 				if (limit <= 0)
 					break;
 				
-				if (limit <= 2 && it->first < 30 || limit <= 4 && it->first < 20)
+				if (limit <= params.lowValueLimit1 && it->first < params.lowValue1 || limit <= params.lowValueLimit2 && it->first < params.lowValue2)
 					continue;
 				
 				it->second->set_elevator.insert(elevator.id);
@@ -265,6 +343,13 @@ struct ElevatorStrategyUpDown
 	}
 };
 
+// Candidate floors of recalcDestinationBeforeDoorsClose
+struct PruneStats
+{
+	int64_t evaluated = 0;
+	int64_t pruned = 0;     // rollouts avoided
+};
+
 class MyStrategy
 {
 public:
@@ -274,12 +359,43 @@ public:
 	ElevatorStrategyUpDown strategy2;
 	ElevatorStrategyUpDown strategy3;
 	ElevatorStrategyUpDown strategy4;
+	PlannerHandle planner;
+	OpponentModelType rolloutOpponent = OpponentModelType::IDLE;
+	PruneStats pruneStats;
+	const StateEvaluator *evaluator = nullptr; // scores the rollouts in place of getRolloutValue
 
     MyStrategy(Side side);
     ~MyStrategy();
 	
+	void setParams(const StrategyParams &params);
+	const StrategyParams &getParams() const { return strategy1.params; }
+	ElevatorStrategyUpDown &getElevatorStrategy(int ind);
+	
+	void setPlannerMode(PlannerMode mode);
+	// Rollouts of evaluator->horizon ticks scored by evaluator, nullptr - the usual ones
+	void setEvaluator(const StateEvaluator *evaluator);
+	ClosingPlanner *getPlanner() const { return planner.planner.get(); }
+	
 	void makeMove(Simulator &inputSim);
 	void makeMove();
 };
 
+// Rollout of one candidate floor, can be advanced in slices
+struct DestinationRollout
+{
+	MyStrategy copy;
+	std::unique_ptr<OpponentModel> opponent; // of copy.rolloutOpponent
+	int floor = -1;
+	int tick = 0;
+	int length = 0;
+	float coef = 1.0f;
+
+	DestinationRollout(const MyStrategy &strategy);
+	~DestinationRollout();
+
+	bool isDone() const { return tick >= length; }
+	// Simulates up to ticks more ticks, returns how many
+	int advance(int ticks);
+};
+
 #endif // MYSTRATEGY_H
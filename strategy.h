@@ -1,10 +1,22 @@
 
 #define HEADER_OLNY_INLINE inline
 #define HEADER_OLNY_STATIC static
+#include "AsyncLog.hpp"
+#include "AsyncLog.cpp"
 #include "Strategy.hpp"
 #include "Strategy.cpp"
 #include "mystrategy.hpp"
+#include "Evaluator.hpp"
+#include "OpponentModel.hpp"
+#include "Planner.hpp"
 #include "mystrategy.cpp"
+#include "Evaluator.cpp"
+#include "OpponentModel.cpp"
+#include "Planner.cpp"
+#include "TickProfiler.hpp"
+#include "TickProfiler.cpp"
+#include "Divergence.hpp"
+#include "Divergence.cpp"
 
 
 
@@ -23,18 +35,69 @@
 class Strategy : public BaseStrategy
 {
     std::unique_ptr<MyStrategy> myStrategy;
-    std::map<int, int> myToApiElIdMap;
-    std::map<int, int> apiToMyElIdMap;
-    std::set<int> registeredPassengers;
-    std::map<int, std::bitset<LEVELS_COUNT> > visitedLevels;
+    Side side;
+
+    // Flat id-indexed tables reused every tick, they only grow while new ids appear
+    static constexpr int ELEVATORS_TOTAL = ELEVATORS_COUNT * 2;
+    int myToApiElId[ELEVATORS_TOTAL];
+    std::vector<int> apiToMyElId;          // -1 for unknown api ids
+    Elevator *myElById[ELEVATORS_TOTAL];   // by MyElevator id, our elevators only
+    std::vector<Passenger *> passById;     // by passenger id, this tick's passengers
+    std::vector<int> passIds;              // ids set in passById this tick
+
+    // What the adapter learned about a passenger, ids are dense and sequential
+    struct PassengerRecord
+    {
+        uint16_t visitedLevels = 0; // bit per floor
+        bool registered = false;
+        int8_t side = -1;           // cached getSide(type), -1 - not known yet
+    };
+    std::vector<PassengerRecord> passRecords; // by passenger id
+
+    // Where the server disagreed with the shadow simulator's prediction
+    DivergenceTracker divergence;
+
+    // Writes only a changed value, tracks the change unless the object is new
+    template <typename T>
+    void syncField(T &mine, const T &server, DivergenceField field, bool track = true)
+    {
+        if (track ? divergence.compare(field, mine, server) : !(mine == server))
+            mine = server;
+    }
+
+    // 120 s of CPU per 7200-tick game, i.e. the average per-tick allowance
+    static constexpr uint64_t TICK_BUDGET_NS = 120000000000ull / 7200;
+    static constexpr int LAST_TICK = 7199;
+    TickProfiler profiler;
+    bool profilerDumped = false;
 public:
+    Strategy()
+    {
+        profiler.budgetNs = TICK_BUDGET_NS;
+        passById.reserve(512);
+        passIds.reserve(512);
+        passRecords.reserve(512);
+    }
+
+    ~Strategy()
+    {
+        dumpProfiler();
+    }
+
     void on_tick(std::vector<Elevator>& myElevators, std::vector<Passenger>& myPassengers, std::vector<Elevator>& enemyElevators, std::vector<Passenger>& enemyPassengers)
     {
-        Side side = getSide(myElevators[0].type);
+        profiler.beginTick();
 
         if (!myStrategy)
         {
+            side = getSide(myElevators[0].type);
             myStrategy.reset(new MyStrategy(side));
+#ifdef PLANNER_MODE
+            myStrategy->setPlannerMode(PlannerMode::PLANNER_MODE);
+#endif
+#ifdef ROLLOUT_OPPONENT
+            myStrategy->rolloutOpponent = OpponentModelType::ROLLOUT_OPPONENT;
+#endif
             for (int i = 0; i < 4; ++i)
             {
                 for (int myI = 0; myI < 8; ++myI)
@@ -43,66 +106,71 @@ public:
 
                     if (myElevator.ind == i)
                     {
-                        if (side == myElevator.side)
-                        {
-                            myToApiElIdMap[myElevator.id] = myElevators[i].id;
-                            apiToMyElIdMap[myElevators[i].id] = myElevator.id;
-                        }
-                        else
-                        {
-                            myToApiElIdMap[myElevator.id] = enemyElevators[i].id;
-                            apiToMyElIdMap[enemyElevators[i].id] = myElevator.id;
-                        }
+                        int apiId = side == myElevator.side ? myElevators[i].id : enemyElevators[i].id;
+                        myToApiElId[myElevator.id] = apiId;
+                        if (apiId >= (int) apiToMyElId.size())
+                            apiToMyElId.resize(apiId + 1, -1);
+                        apiToMyElId[apiId] = myElevator.id;
                     }
                 }
             }
         }
 
-        std::map<int, Passenger*> passById;
-        std::map<int, Elevator*> myElById;
+        divergence.beginTick(myStrategy->sim.tick);
+
+        for (int id : passIds)
+            passById[id] = nullptr;
+        passIds.clear();
+        for (Elevator *&e : myElById)
+            e = nullptr;
 
         for (Passenger &p : myPassengers)
         {
             syncPass(p);
-            passById[p.id] = &p;
+            setPassById(p);
         }
 
         for (Passenger &p : enemyPassengers)
         {
             syncPass(p);
-            passById[p.id] = &p;
+            setPassById(p);
         }
 
         for (Elevator &e : myElevators)
         {
+            int id = getMyElevatorId(e.id);
+            if (id >= 0)
+                myElById[id] = &e;
             syncElevator(e, true);
-            myElById[e.id] = &e;
         }
 
         for (Elevator &e : enemyElevators)
             syncElevator(e, false);
 
+        profiler.mark(TickPhase::SYNC);
+
         myStrategy->makeMove();
 
+        profiler.mark(TickPhase::MAKE_MOVE);
+
         for (const std::pair<const int, MyPassenger> & passenger : myStrategy->sim.passengers)
         {
             int id = passenger.first;
             const MyPassenger &otherPass = passenger.second;
 
-            Passenger *thisPass = passById[id];
+            Passenger *thisPass = id < (int) passById.size() ? passById[id] : nullptr;
             if (!thisPass)
             {
-                std::cout << myStrategy->sim.tick << " Passenger not found " << myStrategy->sim.tick << " " << id << " " << otherPass.x << " " << otherPass.y << " " << getPStateName(otherPass.state) << " " << otherPass.time_to_away <<
-                             std::endl;
+                divergence.record(DivergenceField::PASS_MISSING, 1.0, 0.0);
             }
             else
             {
                 for (int i : otherPass.set_elevator)
                 {
-                    Elevator *el = myElById[myToApiElIdMap[i]];
+                    Elevator *el = myElById[i];
                     if (!el)
                     {
-                        std::cout << "Elevator not found " << i << std::endl;
+                        LOGE(myStrategy->sim.tick, "Elevator not found", i);
                     }
                     else
                     {
@@ -120,10 +188,10 @@ public:
 
             if (elevator.side == side)
             {
-                Elevator *thisElevator = myElById[myToApiElIdMap[elevator.id]];
+                Elevator *thisElevator = myElById[elevator.id];
                 if (!thisElevator)
                 {
-                    std::cout << "Elevator not found2 " << elevator.id << std::endl;
+                    LOGE(myStrategy->sim.tick, "Elevator not found2", elevator.id);
                 }
                 else
                 {
@@ -132,15 +200,58 @@ public:
             }
         }
 
+        divergence.endTick();
+        profiler.mark(TickPhase::COMMANDS);
+
+        int tick = myStrategy->sim.tick;
         myStrategy->sim.step();
+
+        profiler.mark(TickPhase::SIM_STEP);
+        profiler.endTick(tick);
+
+        if (tick >= LAST_TICK)
+            dumpProfiler();
+    }
+
+    void dumpProfiler()
+    {
+        if (profilerDumped || !profiler.total.totalCount)
+            return;
+
+        profilerDumped = true;
+        flushLog();
+        profiler.dump(std::cout);
+        divergence.dump(std::cout);
+        if (myStrategy && myStrategy->getPlanner())
+            myStrategy->getPlanner()->dump(std::cout);
+        if (myStrategy && myStrategy->getParams().pruneBound >= 0)
+            std::cout << "CANDIDATES evaluated " << myStrategy->pruneStats.evaluated << " pruned " << myStrategy->pruneStats.pruned << std::endl;
+    }
+
+    void setPassById(Passenger &p)
+    {
+        if (p.id >= (int) passById.size())
+            passById.resize(p.id + 1, nullptr);
+        passById[p.id] = &p;
+        passIds.push_back(p.id);
+    }
+
+    int getMyElevatorId(int apiId) const
+    {
+        return apiId >= 0 && apiId < (int) apiToMyElId.size() ? apiToMyElId[apiId] : -1;
+    }
+
+    PassengerRecord &getPassengerRecord(int id)
+    {
+        if (id >= (int) passRecords.size())
+            passRecords.resize(id + 1);
+        return passRecords[id];
     }
 
     void syncPass(Passenger &otherPass)
     {
-        if (!visitedLevels.count(otherPass.id))
-        {
-            visitedLevels[otherPass.id].set(0);
-        }
+        PassengerRecord &record = getPassengerRecord(otherPass.id);
+        record.visitedLevels |= 1;
 
         PState pstate = convertPState(otherPass.state);
         if (pstate == PState::EXITING || pstate == PState::MOVING_TO_FLOOR)
@@ -151,51 +262,48 @@ public:
         bool exists = sim.passengers.count(id);
         MyPassenger &thisPass = sim.passengers[id];
         if (!id)
-            std::cout << "ERR3 " << id << std::endl;
+            LOGE(sim.tick, "ERR3", id);
 
-        thisPass.x = otherPass.x;
-        thisPass.y = otherPass.y - 1.0;
-        thisPass.from_floor = otherPass.from_floor - 1;
-        thisPass.dest_floor = otherPass.dest_floor - 1;
+        syncField(thisPass.x, otherPass.x, DivergenceField::PASS_X, exists);
+        syncField(thisPass.y, otherPass.y - 1.0, DivergenceField::PASS_Y, exists);
+        syncField(thisPass.from_floor, otherPass.from_floor - 1, DivergenceField::PASS_FROM, exists);
+        syncField(thisPass.dest_floor, otherPass.dest_floor - 1, DivergenceField::PASS_DEST, exists);
         thisPass.dest_floor_confirmed = true;
-        thisPass.time_to_away = otherPass.time_to_away;
+        syncField(thisPass.time_to_away, otherPass.time_to_away, DivergenceField::PASS_TTA, exists);
         if (thisPass.time_to_away == 0)
-            std::cout << sim.tick << " TTA " << otherPass.id << std::endl;
-        if (!apiToMyElIdMap.count(otherPass.elevator))
-            thisPass.elevator = -1;
-        else
-            thisPass.elevator = apiToMyElIdMap[otherPass.elevator];
-        thisPass.state = convertPState(otherPass.state);
-        thisPass.mass = otherPass.weight;
+            LOGI(sim.tick, "TTA", otherPass.id);
+        syncField(thisPass.elevator, getMyElevatorId(otherPass.elevator), DivergenceField::PASS_ELEVATOR, exists);
+        if (exists)
+            divergence.compare(DivergenceField::PASS_STATE, (int) thisPass.state, (int) pstate);
+        thisPass.state = pstate;
+        syncField(thisPass.mass, (float) otherPass.weight, DivergenceField::PASS_MASS, exists);
 
         if (pstate == PState::WAITING_FOR_ELEVATOR) {
-            visitedLevels[otherPass.id].set(thisPass.getFloor());
+            record.visitedLevels |= 1 << thisPass.getFloor();
         }
         else if (pstate == PState::USING_ELEVATOR) {
-            visitedLevels[otherPass.id].set(thisPass.dest_floor);
+            record.visitedLevels |= 1 << thisPass.dest_floor;
         }
         else if (pstate == PState::MOVING_TO_FLOOR) {
-            visitedLevels[otherPass.id].set(thisPass.dest_floor);
+            record.visitedLevels |= 1 << thisPass.dest_floor;
         }
 
-        for (int i = 0; i < LEVELS_COUNT; ++i)
-        {
-            if (visitedLevels[otherPass.id].test(i))
-                thisPass.visitedLevels.set(i);
-        }
+        thisPass.visitedLevels |= std::bitset<LEVELS_COUNT>(record.visitedLevels);
 
-        if (!registeredPassengers.count(otherPass.id) || !exists)
+        if (!record.registered || !exists)
         {
-            if (registeredPassengers.count(otherPass.id))
-                std::cout << sim.tick << " ERR ALREADY REGISTERED " << otherPass.id << std::endl;
+            if (record.registered)
+                divergence.record(DivergenceField::PASS_REREGISTERED, 1.0, 0.0);
             else
-                registeredPassengers.insert(otherPass.id);
+                record.registered = true;
 
-            std::cout << sim.tick << " REG " << otherPass.id << std::endl;
+            LOGI(sim.tick, "REG", otherPass.id);
 
             thisPass.id = otherPass.id;
             thisPass.spawn_x = thisPass.x > 0 ? 20.0 : -20.0;
-            thisPass.side = getSide(otherPass.type);
+            if (record.side == -1)
+                record.side = (int8_t) getSide(otherPass.type);
+            thisPass.side = (Side) record.side;
             thisPass.placesRemained = 4;
 
             std::set<int> placesSet;
@@ -216,36 +324,45 @@ public:
     void syncElevator(Elevator &elevator, bool my)
     {
         Simulator &sim = myStrategy->sim;
-        MyElevator &thisElevator = sim.elevators[apiToMyElIdMap[elevator.id]];
+        int id = getMyElevatorId(elevator.id);
+        if (id < 0)
+        {
+            LOGE(sim.tick, "Unknown elevator", elevator.id);
+            return;
+        }
+        MyElevator &thisElevator = sim.elevators[id];
 
          EState state = convertEState(elevator.state);
          if (state == EState::WAITING)
               state = EState::CLOSING;
 
-        if (my && thisElevator.state != state)
-            std::cout << sim.tick << " WRONG STATE " << getEStateName(thisElevator.state) << " " << getEStateName(state)
-             << " ttf " << thisElevator.time_to_floor << " nf " << thisElevator.next_floor << " id " << elevator.id << std::endl;
-
+        // Enemy elevators aren't predicted, their mismatches go to the enemy fields
+        bool stateDiverged = divergence.compare(my ? DivergenceField::EL_STATE : DivergenceField::ENEMY_EL_STATE,
+            (int) thisElevator.state, (int) state);
 
-        thisElevator.y = elevator.y - 1.0;
-        thisElevator.speed = elevator.speed;
+        syncField(thisElevator.y, elevator.y - 1.0, my ? DivergenceField::EL_Y : DivergenceField::ENEMY_EL_Y);
+        syncField(thisElevator.speed, elevator.speed, my ? DivergenceField::EL_SPEED : DivergenceField::ENEMY_EL_SPEED);
         if (convertEState(elevator.state) == EState::FILLING && thisElevator.state != EState::FILLING)
             thisElevator.time_on_the_floor_with_opened_doors = 0;
 
-        if (elevator.next_floor == -1)
-            thisElevator.next_floor = -1;
-        else
-            thisElevator.next_floor = elevator.next_floor - 1;
-
-
+        syncField(thisElevator.next_floor, elevator.next_floor == -1 ? -1 : elevator.next_floor - 1,
+            my ? DivergenceField::EL_NEXT_FLOOR : DivergenceField::ENEMY_EL_NEXT_FLOOR);
 
-        if (thisElevator.state != state)
+        if (stateDiverged)
             thisElevator.setState(state, sim);
 
+        // Rebuild the roster only when somebody boarded or left
+        bool sameRoster = thisElevator.passengers.size() == elevator.passengers.size();
+        for (size_t i = 0; sameRoster && i < elevator.passengers.size(); ++i)
+            sameRoster = thisElevator.passengers.count(elevator.passengers[i].id) > 0;
 
-        thisElevator.passengers.clear();
-        for (Passenger &p : elevator.passengers)
-            thisElevator.passengers.insert(p.id);
+        if (!sameRoster)
+        {
+            divergence.record(my ? DivergenceField::EL_ROSTER : DivergenceField::ENEMY_EL_ROSTER, (double) thisElevator.passengers.size(), (double) elevator.passengers.size());
+            thisElevator.passengers.clear();
+            for (Passenger &p : elevator.passengers)
+                thisElevator.passengers.insert(p.id);
+        }
     }
 
     EState convertEState(int state)
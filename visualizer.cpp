@@ -0,0 +1,771 @@
+#include <iostream>
+
+#include <GL/glew.h>
+#include <SDL2/SDL.h>
+#include <vector>
+#include <set>
+#include <sstream>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <cstring>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include "MyUtils.hpp"
+
+#ifndef NANOVG_FONT
+#define NANOVG_FONT "Roboto-Regular.ttf"
+#endif
+
+#define NANOVG_GL2_IMPLEMENTATION	// Use GL2 implementation.
+#include "nanovg.h"
+#include "nanovg_gl.h"
+#include "Strategy.hpp"
+#include "mystrategy.hpp"
+#include "StrategyRegistry.hpp"
+#include "Replay.hpp"
+#include "TripleBuffer.hpp"
+
+struct Renderer {
+	void init();
+	void startRendering();
+	void finishRendering();
+	void renderPoint(const P &p);
+};
+
+constexpr int WIDTH = 1300;
+constexpr int HEIGHT = 1000;
+
+SDL_Window *window;
+SDL_GLContext glContext;
+NVGcontext* vg;
+
+double SCALE = 0.9;
+double zoom = 1.0;
+P zoomCenter = P(0.5, 0.5);
+
+std::vector<P> points;
+
+void Renderer::init()
+{
+	int width = (int) (WIDTH * SCALE);
+	int height = (int) (HEIGHT * SCALE);
+
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+			return;
+
+	window = SDL_CreateWindow("My Game Window",
+		SDL_WINDOWPOS_UNDEFINED,
+		SDL_WINDOWPOS_UNDEFINED,
+		width, height,
+		SDL_WINDOW_SHOWN | SDL_WINDOW_OPENGL);
+
+	glContext = SDL_GL_CreateContext(window);
+	if (glContext == NULL)
+	{
+		printf("There was an error creating the OpenGL context!\n");
+		return;
+	}
+
+	const unsigned char *version = glGetString(GL_VERSION);
+	if (version == NULL)
+	{
+		printf("There was an error creating the OpenGL context!\n");
+		return;
+	}
+
+	SDL_GL_MakeCurrent(window, glContext);
+
+	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 2);
+	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 1);
+	SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
+	SDL_GL_SetSwapInterval(1);
+
+	//MUST make a context AND make it current BEFORE glewInit()!
+	glewExperimental = GL_TRUE;
+	GLenum glew_status = glewInit();
+	if (glew_status != 0)
+	{
+		fprintf(stderr, "Error: %s\n", glewGetErrorString(glew_status));
+		return;
+	}
+
+	glViewport( 0, 0, width, height);
+}
+
+void updateZoom()
+{
+    glMatrixMode(GL_PROJECTION);
+
+    P center = zoomCenter * P(WIDTH, HEIGHT);
+    P c1 = center - P(WIDTH, HEIGHT) * 0.5 / zoom;
+    P c2 = center + P(WIDTH, HEIGHT) * 0.5 / zoom;
+
+    if (c2.x > WIDTH)
+    {
+        double d = c2.x - WIDTH;
+        c1.x -= d;
+        c2.x -= d;
+    }
+
+    if (c2.y > HEIGHT)
+    {
+        double d = c2.y - HEIGHT;
+        c1.y -= d;
+        c2.y -= d;
+    }
+
+    if (c1.x < 0)
+    {
+        double d = -c1.x;
+        c1.x += d;
+        c2.x += d;
+    }
+
+    if (c1.y < 0)
+    {
+        double d = -c1.y;
+        c1.y += d;
+        c2.y += d;
+    }
+
+    zoomCenter = (c1 + c2) / 2.0 / P(WIDTH, HEIGHT);
+
+    //LOG("ZOOM " << zoomCenter);
+    glLoadIdentity();
+    glOrtho(c1.x, c2.x, c2.y, c1.y, 0.0, 1.0);
+}
+
+void Renderer::startRendering()
+{
+	points.clear();
+}
+
+void renderCircle(P p, double rad)
+{
+	glBegin ( GL_TRIANGLE_FAN );
+
+	glVertex2d ( p.x, p.y );
+
+	double N = 200;
+
+	for ( double i = 0; i <= N; ++i ) {
+		double alpha = i * PI * 2.0 / N;
+		P p2 = P (rad  * std::cos ( alpha ), rad * std::sin ( alpha ) ) + p;
+		glVertex2d ( p2.x, p2.y );
+	}
+
+	glEnd();
+}
+
+float floorCoord(float y)
+{
+	return 950.0f - y*100.0f;
+}
+
+Simulator *g_realsimulator = nullptr;
+Simulator *g_mysimulator = nullptr;
+bool renderMySim = false;
+
+void renderPassenger(MyPassenger &passenger, bool isOut)
+{
+	Simulator *g_simulator = renderMySim ? g_mysimulator : g_realsimulator;
+	
+	float passW2 = 10;
+	float passH = 40;
+	
+	double y = passenger.y;
+	
+	if (isOut)
+	{
+		if (passenger.state == PState::MOVING_TO_FLOOR)
+		{
+			int ticksPassed = g_simulator->tick - passenger.ticks;
+			int ticksToArrive = std::abs(passenger.dest_floor - passenger.from_floor) * 100;
+			if (passenger.dest_floor > passenger.from_floor)
+				ticksToArrive *= 2;
+			
+			if (ticksPassed > ticksToArrive)
+				return;
+			
+			y = passenger.from_floor + (float)(passenger.dest_floor - passenger.from_floor) * (float) ticksPassed / (float) ticksToArrive;
+		}
+		else if (passenger.state == PState::EXITING)
+		{
+			int ticksPassed = g_simulator->tick - passenger.ticks;
+			if (ticksPassed > 40)
+				return;
+		}
+	}
+	
+	if (passenger.state == PState::WAITING_FOR_ELEVATOR)
+		glColor3f(0.7, 0.7, 0.7);
+	else if (passenger.state == PState::MOVING_TO_ELEVATOR)
+		glColor3f(0.2, 0.8, 0.2);
+	else if (passenger.state == PState::RETURNING)
+		glColor3f(0.8, 0.2, 0.2);
+	else if (passenger.state == PState::MOVING_TO_FLOOR)
+		glColor3f(0.9, 0.0, 0.0);
+	else if (passenger.state == PState::USING_ELEVATOR)
+		glColor3f(0.0, 0.9, 0.0);
+	else if (passenger.state == PState::EXITING)
+		glColor3f(0.0, 0.5, 0.9);
+	else
+		glColor3f(0.0, 0.0, 0.0);
+	
+	float y1 = floorCoord(y);
+	float y2 = y1 - passH;
+	
+	float passX = WIDTH / 2.0f + passenger.x;
+	glBegin(GL_LINE_STRIP);
+	glVertex2f(passX - passW2, y1);
+	glVertex2f(passX + passW2, y1);
+	glVertex2f(passX + passW2, y2);
+	glVertex2f(passX - passW2, y2);
+	glVertex2f(passX - passW2, y1);
+	glEnd();
+	
+	int idx = passenger.id / 20;
+	int idy = passenger.id % 20;
+	
+	float dd = 0.1;
+	float x1 = passX + idx / 5.0f * passW2 - passW2 + dd;
+	float x2 = passX + (idx + 1) / 5.0f * passW2 - passW2 - dd;
+	
+	y1 = floorCoord(y) - idy / 20.0f * passH + dd;
+	y2 = floorCoord(y) - (idy + 1) / 20.0f * passH - dd;
+	
+	glBegin(GL_TRIANGLES);
+	if ((float) passenger.dest_floor > y)
+	{
+		glVertex2f(x1, y1);
+		glVertex2f(x2, y1);
+		glVertex2f((x1 + x2)*0.5f, y2);
+	}
+	else
+	{
+		glVertex2f((x1 + x2)*0.5f, y1);
+		glVertex2f(x2, y2);
+		glVertex2f(x1, y2);
+	}
+	glEnd();
+}
+
+void renderSimulator()
+{
+	Simulator *g_simulator = renderMySim ? g_mysimulator : g_realsimulator;
+	if (!g_simulator)
+		return;
+	
+	glColor3f(0.9, 0.9, 0.9);
+	
+	glBegin(GL_LINES);
+	glVertex2f(WIDTH / 2.0f, 0.0f);
+	glVertex2f(WIDTH / 2.0f, HEIGHT);
+	glEnd();
+	
+	glColor3f(0.7, 0.7, 0.7);
+	
+	for (MyElevator &el : g_simulator->elevators)
+	{
+		float x = WIDTH / 2.0f + el.x;
+		glBegin(GL_LINES);
+		glVertex2f(x, 0.0f);
+		glVertex2f(x, HEIGHT);
+		glEnd();
+	}
+	
+	for (int y = 0; y < LEVELS_COUNT; ++y)
+	{
+		glBegin(GL_LINES);
+		glVertex2f(0, floorCoord(y));
+		glVertex2f(WIDTH, floorCoord(y));
+		glEnd();
+	}
+	
+	const float elevatorW05 = 25.0;
+	for (MyElevator &el : g_simulator->elevators)
+	{
+		if (el.state == EState::FILLING)
+			glColor3f(0.9, 0.9, 0.0);
+		else if (el.state == EState::MOVING || el.state == EState::OPENING || el.state == EState::CLOSING)
+			glColor3f(0.4, 0.4, 0.2);
+		else
+			glColor3f(0.9, 0.9, 0.0);
+		
+		float x = WIDTH / 2.0f + el.x;
+		float y1 = floorCoord(el.y + 0.9f);
+		float y2 = floorCoord(el.y);
+
+		glBegin(GL_QUADS);
+		glVertex2f(x - elevatorW05, y1);
+		glVertex2f(x + elevatorW05, y1);
+		glVertex2f(x + elevatorW05, y2);
+		glVertex2f(x - elevatorW05, y2);
+		glEnd();
+		
+		if (el.state == EState::OPENING || el.state == EState::CLOSING) {
+			glColor3f(0.9, 0.9, 0.0);
+			
+			float w = (el.state == EState::OPENING) ? (el.closing_or_opening_ticks / 100.0) : (1.0 - el.closing_or_opening_ticks / 100.0);
+			w *= elevatorW05;
+			glBegin(GL_QUADS);
+			glVertex2f(x - w, y1);
+			glVertex2f(x + w, y1);
+			glVertex2f(x + w, y2);
+			glVertex2f(x - w, y2);
+			glEnd();
+		}
+	}
+	
+	int passByState[(int) PState::COUNT] = {};
+	for (std::pair<const int, MyPassenger> & passengerEntry : g_simulator->passengers)
+	{
+		MyPassenger &passenger = passengerEntry.second;
+		renderPassenger(passenger, false);
+		passByState[(int) passenger.state]++;
+	}
+	
+	glColor3d(1.0, 0.0, 0.0);
+		//renderCircle(P(100, 100), 50);
+		
+    int w, h;
+    SDL_GetWindowSize(window, &w, &h);
+    nvgBeginFrame(vg, w, h, 1);
+
+    nvgFontFace(vg, "sans");
+    nvgFontSize(vg, 15.0f);
+    nvgTextAlign(vg, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
+    nvgFillColor(vg, nvgRGBA(0, 0, 0, 255));
+	std::stringstream oss;
+	oss << "Tick " << g_simulator->tick;
+    nvgText(vg, 10, 20, oss.str().c_str(), nullptr);
+	
+	passByState[(int) PState::OUT] = g_simulator->outPassengers.size();
+	for (int i = 0; i < (int) PState::COUNT; ++i)
+	{
+		oss.str("");
+		oss << getPStateName((PState) i) << ": " << passByState[i];
+		nvgText(vg, 10, 20 + (i + 1) * 15, oss.str().c_str(), nullptr);
+	}
+	
+	nvgFontSize(vg, 25.0f);
+	nvgTextAlign(vg, NVG_ALIGN_LEFT | NVG_ALIGN_BOTTOM);
+	oss.str("");
+	Value valLeft = g_simulator->totalCargoValue2(Side::LEFT);
+	oss << g_simulator->scores[0] << "/" << valLeft.points << "/" << valLeft.ticks;
+	nvgText(vg, 20, h - 30, oss.str().c_str(), nullptr);
+	
+	nvgTextAlign(vg, NVG_ALIGN_RIGHT | NVG_ALIGN_BOTTOM);
+	oss.str("");
+	Value valRight = g_simulator->totalCargoValue2(Side::RIGHT);
+	oss << g_simulator->scores[1] << "/" << valRight.points << "/" << valRight.ticks;
+	nvgText(vg, w - 20, h - 30, oss.str().c_str(), nullptr);
+	
+	for (MyElevator &el : g_simulator->elevators)
+	{
+		float y = floorCoord(el.y);
+		float x = WIDTH / 2.0f + el.x;
+		
+		nvgFontSize(vg, 20.0f);
+		nvgTextAlign(vg, NVG_ALIGN_CENTER | NVG_ALIGN_TOP);
+		oss.str("");
+		oss << "->" << el.next_floor << " " << el.passengers.size();
+		
+		P mousePos = (P(x / WIDTH, y / HEIGHT) - zoomCenter) * zoom + P(0.5, 0.5);
+		P p = mousePos * P(WIDTH * SCALE, HEIGHT*SCALE);
+		nvgText(vg, p.x, p.y, oss.str().c_str(), nullptr);
+	}
+	
+	int leftOutPass[LEVELS_COUNT] = {};
+	int rightOutPass[LEVELS_COUNT] = {};
+	int leftOutTick[LEVELS_COUNT] = {};
+	int rightOutTick[LEVELS_COUNT] = {};
+	
+	for (std::pair<const int, MyPassenger> &p : g_simulator->outPassengers)
+	{
+		MyPassenger &passenger = p.second;
+		renderPassenger(passenger, true);
+		passByState[(int) passenger.state]++;
+		
+		int tick = p.first;
+		int floor = p.second.getFloor();
+		if (p.second.side == Side::LEFT)
+		{
+			leftOutPass[floor]++;
+			if (!leftOutTick[floor])
+				leftOutTick[floor] = tick;
+		}
+		else
+		{
+			rightOutPass[floor]++;
+			if (!rightOutTick[floor])
+				rightOutTick[floor] = tick;
+		}
+	}
+	
+	for (int i = 0; i < LEVELS_COUNT; ++i)
+	{
+		float y = floorCoord(i);
+		
+		nvgFontSize(vg, 15.0f);
+		nvgTextAlign(vg, NVG_ALIGN_CENTER | NVG_ALIGN_BOTTOM);
+		
+		P mousePos = (P(-350.0 / WIDTH + 0.5, y / HEIGHT) - zoomCenter) * zoom + P(0.5, 0.5);
+		P p = mousePos * P(WIDTH * SCALE, HEIGHT*SCALE);
+		
+		oss.str("");
+		oss << leftOutPass[i];
+		if (leftOutPass[i])
+			oss << " - " << (leftOutTick[i] - g_simulator->tick);
+		nvgText(vg, p.x, p.y, oss.str().c_str(), nullptr);
+		
+		mousePos = (P(+350.0 / WIDTH + 0.5, y / HEIGHT) - zoomCenter) * zoom + P(0.5, 0.5);
+		p = mousePos * P(WIDTH * SCALE, HEIGHT*SCALE);
+		
+		oss.str("");
+		oss << rightOutPass[i];
+		if (rightOutPass[i])
+			oss << " - " << (rightOutTick[i] - g_simulator->tick);
+		nvgText(vg, p.x, p.y, oss.str().c_str(), nullptr);
+	}
+
+    /*P mousePos = (P(100, 100) / WIDTH - zoomCenter) * zoom + P(0.5, 0.5);
+    P p = mousePos * P(WIDTH * SCALE, HEIGHT*SCALE);
+    nvgText(vg, p.x, p.y, oss.str().c_str(), nullptr);*/
+
+    nvgEndFrame(vg);
+}
+
+int renderTickMod = 1;
+bool g_replayMode = false;
+
+// World state as the render thread sees it, published by the simulation thread
+struct WorldSnapshot
+{
+	Simulator real;
+	Simulator my;
+	bool hasMy = false;
+};
+
+TripleBuffer<WorldSnapshot> g_snapshots;
+
+// Render thread -> simulation thread
+struct SimControl
+{
+	std::atomic<bool> pause{true};
+	std::atomic<int> stepTicks{0};   // ticks to play while paused
+	std::atomic<int> seekTo{-1};     // replay mode
+	std::atomic<double> delay{20.0}; // ms per tick, < 1 - max speed
+	std::atomic<bool> quit{false};
+};
+
+SimControl g_control;
+
+void Renderer::finishRendering()
+{
+	static std::set<int> keys, pressedKeys;
+	static P mousePos = P(0.0, 0.0);
+    static bool lButton = false;
+    static bool updateTitle = true;
+    static P titlePos = P(0, 0);
+
+	{
+		pressedKeys.clear();
+		SDL_Event e;
+		while ( SDL_PollEvent(&e) )
+		{
+			if (e.type == SDL_KEYDOWN)
+			{
+				keys.insert(e.key.keysym.sym);
+				pressedKeys.insert(e.key.keysym.sym);
+				std::cout << "PRESS " << e.key.keysym.sym << std::endl;
+			}
+			if (e.type == SDL_KEYUP)
+			{
+				keys.erase(e.key.keysym.sym);
+			}
+
+            if (e.type == SDL_MOUSEMOTION)
+            {
+                mousePos = P(e.motion.x, e.motion.y) / P(WIDTH * SCALE, HEIGHT*SCALE);
+                if (lButton)
+                {
+                    zoomCenter -= P(e.motion.xrel, e.motion.yrel) / P(WIDTH * SCALE, HEIGHT*SCALE) / zoom;
+                }
+            }
+
+            if (e.type == SDL_MOUSEBUTTONDOWN)
+            {
+                if (e.button.button == SDL_BUTTON_LEFT)
+                    lButton = true;
+            }
+
+            if (e.type == SDL_MOUSEBUTTONUP)
+            {
+                if (e.button.button == SDL_BUTTON_LEFT)
+                    lButton = false;
+            }
+
+            if (e.type == SDL_MOUSEWHEEL)
+            {
+                P zoomPoint = zoomCenter + (mousePos - P(0.5, 0.5))/zoom;
+
+                int w = e.wheel.y;
+                if (w > 0)
+                {
+                    for (int i = 0; i < w; ++i)
+                        zoom *= 1.2;
+                } else
+                {
+                    for (int i = 0; i < -w; ++i)
+                        zoom /= 1.2;
+                }
+
+                if (zoom < 1.0)
+                    zoom = 1.0;
+
+                zoomCenter = zoomPoint - (mousePos - P(0.5, 0.5))/zoom;
+            }
+		}
+
+		if (pressedKeys.count(SDLK_SPACE))
+		{
+			g_control.pause = !g_control.pause;
+			keys.erase(SDLK_SPACE);
+		}
+
+        if (pressedKeys.count(SDLK_KP_0))
+        {
+            LOG("CUR SIM " << currentSimulation);
+        }
+
+        if (pressedKeys.count(SDLK_KP_1))
+        {
+            updateTitle = !updateTitle;
+        }
+		
+		if (pressedKeys.count(SDLK_KP_MULTIPLY))
+		{
+			renderMySim = !renderMySim;
+			if (renderMySim)
+				std::cout << "Render my sim" << std::endl;
+			else
+				std::cout << "Render real sim" << std::endl;
+		}
+		
+		if (pressedKeys.count(SDLK_KP_PLUS))
+		{
+            renderTickMod++;
+		}
+		else if (pressedKeys.count(SDLK_KP_MINUS))
+		{
+			if (renderTickMod > 1)
+				renderTickMod--;
+		}
+
+		if (keys.count(SDLK_UP))
+		{
+			g_control.delay = g_control.delay / 1.5;
+		}
+
+		if (keys.count(SDLK_DOWN))
+		{
+			g_control.delay = std::max(1.0, g_control.delay * 1.5);
+		}
+		
+		if (pressedKeys.count(SDLK_ESCAPE))
+		{
+			g_control.quit = true;
+		}
+
+		glClearColor(1.0, 1.0, 1.0, 0.0);
+		glClear(GL_COLOR_BUFFER_BIT);
+		glClear(GL_DEPTH_BUFFER_BIT);
+        updateZoom();
+				
+		#ifdef SIMULATE
+		//renderFitMap();
+		//::renderExperimentCarCircleCollision();
+		//::renderExperimentCarTraj();
+		//::renderExperimentCarWallCollision();
+		//::renderExperimentCarCarCollision();
+		//::renderExperimentOilSlickEvasion();
+		//::renderExperimentBonuses();
+		//::renderCarRot();
+		#endif
+		
+		renderSimulator();
+		
+		
+
+
+		SDL_GL_SwapWindow(window);
+
+		if (pressedKeys.count(SDLK_RIGHT))
+		{
+			keys.erase(SDLK_RIGHT);
+			g_control.stepTicks += renderTickMod;
+		}
+		
+		if (g_replayMode)
+		{
+			int tick = g_realsimulator->tick;
+			if (pressedKeys.count(SDLK_LEFT))
+				g_control.seekTo = std::max(0, tick - 1);
+			else if (pressedKeys.count(SDLK_PAGEUP))
+				g_control.seekTo = std::max(0, tick - 600);
+			else if (pressedKeys.count(SDLK_PAGEDOWN))
+				g_control.seekTo = tick + 600;
+			else if (pressedKeys.count(SDLK_HOME))
+				g_control.seekTo = 0;
+		}
+	}
+}
+
+void publishSnapshot(const Simulator &real, const Simulator *my)
+{
+	WorldSnapshot &snapshot = g_snapshots.getWriteBuffer();
+	snapshot.real = real;
+	snapshot.hasMy = my != nullptr;
+	if (my)
+		snapshot.my = *my;
+	g_snapshots.publish();
+}
+
+// Simulation thread: plays ticks at the requested speed and never waits for
+// the renderer. While running a snapshot is copied only when the renderer
+// took the previous one, so at max speed the copies cost one per frame.
+void runSimulation(const std::function<bool ()> &step, const std::function<void (int)> &seek,
+	const Simulator &real, const Simulator *my)
+{
+	int publishedTick = real.tick;
+	while (!g_control.quit)
+	{
+		int seekTo = g_control.seekTo.exchange(-1);
+		bool stepping = false;
+		if (seekTo >= 0 && seek)
+			seek(seekTo);
+		else if (!g_control.pause || (stepping = g_control.stepTicks > 0))
+		{
+			if (stepping)
+				--g_control.stepTicks;
+			if (!step())
+				g_control.pause = true;
+		}
+		else
+		{
+			if (publishedTick != real.tick)
+			{
+				publishSnapshot(real, my);
+				publishedTick = real.tick;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			continue;
+		}
+		
+		if (!g_snapshots.hasFresh() || seekTo >= 0)
+		{
+			publishSnapshot(real, my);
+			publishedTick = real.tick;
+		}
+		
+		double delay = g_control.delay;
+		if (!g_control.pause && delay >= 1.0)
+			std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(delay));
+	}
+}
+
+// Render loop on the main thread at the display refresh rate, the simulation
+// runs on its own thread
+int runVisualizer(const std::function<bool ()> &step, const std::function<void (int)> &seek,
+	const Simulator &real, const Simulator *my)
+{
+	publishSnapshot(real, my);
+	
+	Renderer renderer;
+	renderer.init();
+	
+	vg = nvgCreateGL2(NVG_ANTIALIAS | NVG_STENCIL_STROKES);
+	nvgCreateFont(vg, "sans", NANOVG_FONT);
+	
+	std::thread simulation(runSimulation, step, seek, std::cref(real), my);
+	while (!g_control.quit)
+	{
+		g_snapshots.update();
+		WorldSnapshot &snapshot = g_snapshots.getReadBuffer();
+		g_realsimulator = &snapshot.real;
+		g_mysimulator = snapshot.hasMy ? &snapshot.my : &snapshot.real;
+		
+		renderer.startRendering();
+		renderer.finishRendering();
+	}
+	
+	simulation.join();
+	return 0;
+}
+
+// visualizer --replay file [tick]: LEFT / PAGEUP / PAGEDOWN / HOME seek through keyframes
+int playReplay(const std::string &path, int startTick)
+{
+	Replay replay;
+	if (!loadReplay(path, replay))
+		return 1;
+	
+	ReplayIndex index;
+	if (!index.load(getReplayIndexPath(path), replay))
+		index.build(replay, 300);
+	
+	ReplayPlayer player(replay);
+	g_replayMode = true;
+	g_control.seekTo = std::max(0, startTick);
+	
+	return runVisualizer([&]() { return player.step(); },
+		[&](int tick) { index.seek(player, std::min(tick, replay.ticks - 1)); },
+		player.sim, nullptr);
+}
+
+int main(int argc, char **argv) {
+	if (argc > 2 && !strcmp(argv[1], "--replay"))
+		return playReplay(argv[2], argc > 3 ? atoi(argv[3]) : 0);
+	
+	std::string leftName = argc > 1 ? argv[1] : "strat4559";
+	std::string rightName = argc > 2 ? argv[2] : "MyStrategy";
+	int i = argc > 3 ? atoi(argv[3]) : 11;
+	
+	StrategyRegistry registry;
+	registerStrategies(registry);
+	if (!registry.contains(leftName) || !registry.contains(rightName))
+	{
+		std::cerr << "Usage: " << argv[0] << " [left] [right] [game] | --replay file [tick], strategies:";
+		for (const std::string &name : registry.getNames())
+			std::cerr << " " << name;
+		std::cerr << std::endl;
+		return 1;
+	}
+	
+	Simulator simulator;
+	simulator.random.m_w = 210000 + i*12345;
+	
+	std::unique_ptr<IStrategy> stratLeft = registry.create(leftName, Side::LEFT, 30000 + i*89741);
+	std::unique_ptr<IStrategy> stratRight = registry.create(rightName, Side::RIGHT, 0);
+	
+	int tick = 0;
+	return runVisualizer([&]() {
+		if (tick >= 7200)
+			return false;
+		
+		stratLeft->makeMove(simulator);
+		stratRight->makeMove(simulator);
+		simulator.step();
+		++tick;
+		/*if (simulator.passengers.count(0))
+			std::cout << simulator.tick << " " << simulator.passengers[0] << std::endl;
+		
+		if (simulator.passengers.count(1))
+			std::cout << simulator.tick << " " << simulator.passengers[1] << std::endl;*/
+		return true;
+	}, nullptr, simulator, stratRight->getSimulator());
+}